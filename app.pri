@@ -20,6 +20,10 @@ greaterThan(QT_MAJOR_VERSION, 4): {
     IS_QT5 = 1
 
     QT += widgets concurrent
+    qtHaveModule(sql) {
+        QT += sql
+        DEFINES += HAS_QTSQL
+    }
     *-clang*: cache()
 }
 
@@ -47,6 +51,9 @@ SOURCES += src/main.cpp \
            src/qd2charrenamer.cpp \
            src/enums.cpp \
            src/itemdatabase.cpp \
+           src/datasnapshot.cpp \
+           src/chunkeddatafile.cpp \
+           src/tblstringtable.cpp \
            src/propertiesviewerwidget.cpp \
            src/itemsviewerdialog.cpp \
            src/itemstoragetablemodel.cpp \
@@ -55,8 +62,14 @@ SOURCES += src/main.cpp \
            src/helpers.cpp \
            src/finditemsdialog.cpp \
            src/reversebitwriter.cpp \
+           src/bitwriter.cpp \
            src/reversebitreader.cpp \
+           src/itembitbuffer.cpp \
            src/itemparser.cpp \
+           src/itemsdb.cpp \
+           src/itemheader.cpp \
+           src/savetransaction.cpp \
+           src/itemview.cpp \
            src/propertiesdisplaymanager.cpp \
            src/findresultswidget.cpp \
            src/application.cpp \
@@ -80,6 +93,11 @@ HEADERS += src/medianxlofflinetools.h \
            src/enums.h \
            src/colorsmanager.h \
            src/itemdatabase.h \
+           src/itemcodetable.h \
+           src/itemstatids.h \
+           src/datasnapshot.h \
+           src/chunkeddatafile.h \
+           src/tblstringtable.h \
            src/structs.h \
            src/propertiesviewerwidget.h \
            src/itemsviewerdialog.h \
@@ -90,8 +108,14 @@ HEADERS += src/medianxlofflinetools.h \
            src/finditemsdialog.h \
            src/languagemanager.hpp \
            src/reversebitwriter.h \
+           src/bitwriter.h \
            src/reversebitreader.h \
+           src/itembitbuffer.h \
            src/itemparser.h \
+           src/itemsdb.h \
+           src/itemheader.h \
+           src/savetransaction.h \
+           src/itemview.h \
            src/resourcepathmanager.hpp \
            src/propertiesdisplaymanager.h \
            src/findresultswidget.h \
@@ -164,7 +164,7 @@ def main():
     
     if not os.path.exists('d2_items.db'):
         print("❌ ERROR: Database file 'd2_items.db' not found!")
-        print("Please run: python3 scripts/build_item_database.py utils/txt_parser/")
+        print("Please run utils/txt_parser/parse_and_cp (mxl_datac), it creates resources/data/items.db")
         return 1
     
     # Run complete demo
@@ -18,7 +18,7 @@ class D2ItemLookup:
         """Connect to SQLite database"""
         if not os.path.exists(self.db_path):
             print(f"Warning: Database not found at {self.db_path}")
-            print("Run build_item_database.py first to create the database")
+            print("Please run utils/txt_parser/parse_and_cp (mxl_datac), it creates resources/data/items.db")
             return False
             
         try:
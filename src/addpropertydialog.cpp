@@ -146,7 +146,7 @@ void AddPropertyDialog::populatePropertyCombo()
     };
     
     for (const auto& prop : commonProps) {
-        ItemPropertyTxt* propTxt = ItemDataBase::Properties()->value(prop.id);
+        ItemPropertyTxt* propTxt = ItemDataBase::propertyTxt(prop.id);
         if (propTxt) {
             QString displayName = QString("%1 (%2)").arg(prop.name).arg(prop.id);
             _propertyCombo->addItem(displayName, prop.id);
@@ -244,7 +244,7 @@ void AddPropertyDialog::updatePropertyInfo()
     }
     
     // Fallback to ItemDatabase
-    ItemPropertyTxt* propTxt = ItemDataBase::Properties()->value(propertyId);
+    ItemPropertyTxt* propTxt = ItemDataBase::propertyTxt(propertyId);
     if (!propTxt) {
         _propertyInfoLabel->setText(tr("Invalid property selected."));
         _okButton->setEnabled(false);
@@ -289,7 +289,7 @@ void AddPropertyDialog::updateValueRange()
         _valueRangeLabel->setText(tr("Valid range: %1 to %2").arg(minValue).arg(maxValue));
     } else {
         // Fallback to ItemDatabase
-        ItemPropertyTxt* propTxt = ItemDataBase::Properties()->value(propertyId);
+        ItemPropertyTxt* propTxt = ItemDataBase::propertyTxt(propertyId);
         if (!propTxt) {
             _valueRangeLabel->clear();
             return;
@@ -339,7 +339,7 @@ void AddPropertyDialog::updateParameterVisibility()
         return;
     }
     
-    ItemPropertyTxt* propTxt = ItemDataBase::Properties()->value(propertyId);
+    ItemPropertyTxt* propTxt = ItemDataBase::propertyTxt(propertyId);
     if (!propTxt || propTxt->paramBits == 0) {
         _parameterLabel->hide();
         _parameterSpinBox->hide();
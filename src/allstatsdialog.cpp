@@ -3,6 +3,7 @@
 #include "propertiesdisplaymanager.h"
 #include "itemdatabase.h"
 #include "characterinfo.hpp"
+#include "itemstatids.h"
 
 #include <QPushButton>
 
@@ -24,8 +25,11 @@ AllStatsDialog::AllStatsDialog(QWidget *parent /*= 0*/) : QDialog(parent), ui(ne
     if (savedGeometry.isValid())
         restoreGeometry(savedGeometry.toByteArray());
 
-    // fuck consts and enums!
-    const QSet<int> kIgnoreProps = QSet<int>() << 16 << 17 << 75 << 91 << 92 << 125 << 152 << 185 << 186 << 219 << 243 << 252 << 253 << 254 << 263 << 276 << 288 << 296 << 299 << 300 << 372 << 418 << 419 << 421 << 422 << 423 << 424 << 425 << 427 << 442 << 443 << 473 << 474 << 491 << 501;
+    using namespace ItemStatIds;
+    const QSet<int> kIgnoreProps = QSet<int>() << ItemArmorPercent << ItemMaxdamagePercent << ItemMaxdurabilityPercent << ItemReqPercent << ItemLevelreq << ItemThrowable
+        << ItemIndesctructible << PotionStatCap << PotionSkillCap << BlessingsCounter << XSignet26 << ItemReplenishDurability << ItemReplenishQuantity << ItemExtraStack
+        << XSignet36 << ItemNodcht << Si1 << ItemIsHonorific << StrengthBonusWpn << DexterityBonusWpn << ItemNounsock << ItemNeedschallenged << Goblincurse << ScosglenCheck
+        << NotUsed422 << NotUsed423 << NotUsed424 << NotUsed425 << NotUsed427 << StrBonusBlue << ItemUpgraded << LearnEnnead << LearnBlackroad << CubeUpgrade6 << ShrineCounter;
 
     PropertiesMultiMap allProps;
     QMultiHash<QByteArray, int> setItemsHash;
@@ -36,7 +40,7 @@ AllStatsDialog::AllStatsDialog(QWidget *parent /*= 0*/) : QDialog(parent), ui(ne
             PropertiesDisplayManager::addProperties(&allProps, item->props,   &kIgnoreProps);
             PropertiesDisplayManager::addProperties(&allProps, item->rwProps, &kIgnoreProps);
 
-            ItemBase *itemBase = ItemDataBase::Items()->value(item->itemType);
+            ItemBase *itemBase = ItemDataBase::itemBase(item->itemCode());
             foreach (ItemInfo *socketableItem, item->socketablesInfo)
             {
                 PropertiesMap socketableProps = PropertiesDisplayManager::socketableProperties(socketableItem, itemBase->socketableType);
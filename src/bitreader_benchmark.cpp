@@ -0,0 +1,177 @@
+#include "reversebitreader.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QElapsedTimer>
+#include <QStringList>
+
+#include <cstdio>
+
+
+// the string-based reader ReverseBitReader used before it switched to ItemBitBuffer
+class StringBitReader
+{
+public:
+    StringBitReader(const QString &bitString) : _bitString(bitString), _pos(bitString.length()) {}
+
+    qint64 readNumber(int length)
+    {
+        if (_pos - length < 0)
+            return -1;
+        _pos -= length;
+        return _bitString.mid(_pos, length).toLongLong(0, 2);
+    }
+
+private:
+    QString _bitString;
+    int _pos;
+};
+
+// field widths of the item header in the order ItemParser::parseItem reads them, the rest is read as 9-bit property ids
+static const int kFieldLengths[] = { 1, 3, 1, 5, 1, 1, 2, 2, 1, 1, 2, 1, 1, 1, 1, 1, 1, 1, 5, 8, 2, 3, 4, 4, 4, 3, 8, 8, 8, 8, 3, 32, 7, 4 };
+static const int kFieldsNumber = sizeof(kFieldLengths) / sizeof(kFieldLengths[0]);
+
+template<class Reader>
+static qint64 readAllFields(Reader &reader, int bitsTotal)
+{
+    qint64 sum = 0;
+    for (int i = 0, bitsRead = 0; ; ++i)
+    {
+        int length = i < kFieldsNumber ? kFieldLengths[i] : 9;
+        if (bitsRead + length > bitsTotal)
+            break;
+        sum += reader.readNumber(length);
+        bitsRead += length;
+    }
+    return sum;
+}
+
+// an item cut by a false 'JM' boundary: the overrun is thrown and caught like parseItem used to do
+static qint64 readTruncatedThrowing(const ItemBitBuffer &bits, int bitsTotal)
+{
+    ReverseBitReader reader(bits);
+    try
+    {
+        return readAllFields(reader, bitsTotal);
+    }
+    catch (int)
+    {
+        return -1;
+    }
+}
+
+// the same item read in StickyErrors mode and checked once at the end, like parseItem does now
+static qint64 readTruncatedSticky(const ItemBitBuffer &bits, int bitsTotal)
+{
+    ReverseBitReader reader(bits, ReverseBitReader::StickyErrors);
+    qint64 sum = readAllFields(reader, bitsTotal);
+    return reader.hasError() ? -1 : sum;
+}
+
+static void ignoreMessages(QtMsgType, const QMessageLogContext &, const QString &) {}
+
+// usage: bitreader_benchmark [iterations] [file.d2i ...], by default reads all .d2i files in the current directory
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QStringList args = app.arguments().mid(1);
+    int iterations = 20000;
+    if (!args.isEmpty() && args.first().toInt() > 0)
+        iterations = args.takeFirst().toInt();
+    if (args.isEmpty())
+        args = QDir::current().entryList(QStringList() << "*.d2i", QDir::Files);
+
+    QList<QString> bitStrings;
+    QList<ItemBitBuffer> bitBuffers;
+    foreach (const QString &path, args)
+    {
+        QFile f(path);
+        if (!f.open(QIODevice::ReadOnly))
+        {
+            fprintf(stderr, "can't open %s\n", qPrintable(path));
+            continue;
+        }
+        QByteArray itemBytes = f.readAll().mid(2); // skip JM
+
+        QString bitString;
+        for (int i = 0; i < itemBytes.size(); ++i)
+            bitString.prepend(QString("%1").arg(static_cast<quint8>(itemBytes.at(i)), 8, 2, QChar('0')));
+        bitStrings += bitString;
+        bitBuffers += ItemBitBuffer::fromBytes(itemBytes);
+    }
+    if (bitBuffers.isEmpty())
+    {
+        fprintf(stderr, "no items to read\n");
+        return 1;
+    }
+
+    QElapsedTimer timer;
+    qint64 stringSum = 0, bufferSum = 0;
+
+    timer.start();
+    for (int n = 0; n < iterations; ++n)
+    {
+        for (int i = 0; i < bitStrings.size(); ++i)
+        {
+            StringBitReader reader(bitStrings.at(i));
+            stringSum += readAllFields(reader, bitStrings.at(i).length());
+        }
+    }
+    qint64 stringTime = timer.nsecsElapsed();
+
+    timer.restart();
+    for (int n = 0; n < iterations; ++n)
+    {
+        for (int i = 0; i < bitBuffers.size(); ++i)
+        {
+            ReverseBitReader reader(bitBuffers.at(i));
+            bufferSum += readAllFields(reader, bitBuffers.at(i).size());
+        }
+    }
+    qint64 bufferTime = timer.nsecsElapsed();
+
+    // corrupted corpus: every item loses its second half, so each read ends with an overrun
+    QList<ItemBitBuffer> truncatedBuffers;
+    foreach (const ItemBitBuffer &bits, bitBuffers)
+    {
+        ItemBitBuffer truncated(bits);
+        truncated.resize(bits.size() / 2);
+        truncatedBuffers += truncated;
+    }
+    qInstallMessageHandler(ignoreMessages); // overrun warnings would dominate the timings
+
+    qint64 throwingFailures = 0, stickyFailures = 0;
+    timer.restart();
+    for (int n = 0; n < iterations; ++n)
+        for (int i = 0; i < truncatedBuffers.size(); ++i)
+            throwingFailures += readTruncatedThrowing(truncatedBuffers.at(i), bitBuffers.at(i).size()) == -1;
+    qint64 throwingTime = timer.nsecsElapsed();
+
+    timer.restart();
+    for (int n = 0; n < iterations; ++n)
+        for (int i = 0; i < truncatedBuffers.size(); ++i)
+            stickyFailures += readTruncatedSticky(truncatedBuffers.at(i), bitBuffers.at(i).size()) == -1;
+    qint64 stickyTime = timer.nsecsElapsed();
+    qInstallMessageHandler(0);
+
+    printf("%d items x %d iterations\n", bitBuffers.size(), iterations);
+    printf("QString mid/toLongLong: %10.2f ms\n", stringTime / 1e6);
+    printf("packed words:           %10.2f ms\n", bufferTime / 1e6);
+    printf("speedup:                %10.2fx\n", bufferTime ? static_cast<double>(stringTime) / bufferTime : 0.0);
+    printf("truncated, throw/catch: %10.2f ms\n", throwingTime / 1e6);
+    printf("truncated, sticky:      %10.2f ms\n", stickyTime / 1e6);
+    printf("speedup:                %10.2fx\n", stickyTime ? static_cast<double>(throwingTime) / stickyTime : 0.0);
+    if (throwingFailures != stickyFailures)
+    {
+        fprintf(stderr, "overruns differ: %lld != %lld\n", throwingFailures, stickyFailures);
+        return 3;
+    }
+    if (stringSum != bufferSum)
+    {
+        fprintf(stderr, "read values differ: %lld != %lld\n", stringSum, bufferSum);
+        return 2;
+    }
+    return 0;
+}
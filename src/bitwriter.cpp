@@ -0,0 +1,27 @@
+#include "bitwriter.h"
+#include "enums.h"
+
+
+void BitWriter::writeNumber(quint64 value, int length)
+{
+    if (length < 64)
+        value &= (Q_UINT64_C(1) << length) - 1;
+
+    while (length > 0)
+    {
+        int usedBits = _bitsCount % 8;
+        if (!usedBits)
+            _bytes += '\0';
+
+        int chunk = qMin(8 - usedBits, length);
+        _bytes[_bytes.size() - 1] = static_cast<char>(static_cast<quint8>(_bytes.at(_bytes.size() - 1)) | (value << usedBits));
+        value >>= chunk;
+        length -= chunk;
+        _bitsCount += chunk;
+    }
+}
+
+void BitWriter::writeStatCode(int statCode)
+{
+    writeNumber(statCode, Enums::CharacterStats::StatCodeLength);
+}
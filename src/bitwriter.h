@@ -0,0 +1,28 @@
+#ifndef BITWRITER_H
+#define BITWRITER_H
+
+#include <QByteArray>
+
+
+// Appends bit fields to a byte array the way ReverseBitReader reads them back:
+// the first field starts at the lowest bit of the first byte, an incomplete last byte is padded with 0.
+// Used for the character stats section, which is a list of (9-bit code, [param], value) fields.
+class BitWriter
+{
+public:
+    BitWriter() : _bitsCount(0) {}
+
+    void reserve(int bytesCount) { _bytes.reserve(bytesCount); }
+    void writeNumber(quint64 value, int length); // 0 <= length <= 64, higher bits of value are dropped
+    void writeStatCode(int statCode);
+
+    int bitsCount() const { return _bitsCount; }
+    bool isByteAligned() const { return !(_bitsCount % 8); }
+    const QByteArray &bytes() const { return _bytes; }
+
+private:
+    QByteArray _bytes;
+    int _bitsCount;
+};
+
+#endif // BITWRITER_H
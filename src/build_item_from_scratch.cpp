@@ -37,7 +37,7 @@ int main(int argc, char **argv)
 
     // Create fresh ItemInfo and copy fields and bitString
     ItemInfo *item = new ItemInfo();
-    item->itemType = src->itemType;
+    item->setItemType(src->itemType);
     item->isQuest = src->isQuest;
     item->isIdentified = src->isIdentified;
     item->isSocketed = src->isSocketed;
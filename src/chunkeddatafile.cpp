@@ -0,0 +1,201 @@
+#include "chunkeddatafile.h"
+
+#include <QDataStream>
+#include <QtEndian>
+
+
+const QByteArray ChunkedDataFile::kMagic("MXLB");
+const quint32 ChunkedDataFile::kVersion = 1;
+const quint32 ChunkedDataFile::kDefaultLinesPerBlock = 256;
+
+static const int kHeaderSize = 20, kBlockRecordSize = 20;
+
+QByteArray ChunkedDataFile::compressed(const QByteArray &text, quint32 linesPerBlock /*= kDefaultLinesPerBlock*/)
+{
+    if (!linesPerBlock)
+        linesPerBlock = kDefaultLinesPerBlock;
+
+    QList<Block> blocks;
+    QList<QByteArray> compressedBlocks;
+    quint32 linesCount = 0;
+    for (int blockStart = 0; blockStart < text.size(); )
+    {
+        int blockEnd = blockStart;
+        quint32 blockLines = 0;
+        for (; blockEnd < text.size() && blockLines < linesPerBlock; ++blockLines)
+        {
+            int lineEnd = text.indexOf('\n', blockEnd);
+            blockEnd = lineEnd == -1 ? text.size() : lineEnd + 1;
+        }
+
+        QByteArray blockData = QByteArray::fromRawData(text.constData() + blockStart, blockEnd - blockStart), compressedData = qCompress(blockData);
+        Block block = { 0, static_cast<quint32>(compressedData.size()), static_cast<quint32>(blockData.size()), linesCount,
+                        qChecksum(compressedData.constData(), compressedData.size()), qChecksum(blockData.constData(), blockData.size()) };
+        blocks += block;
+        compressedBlocks += compressedData;
+        linesCount += blockLines;
+        blockStart = blockEnd;
+    }
+
+    QByteArray result(kMagic);
+    QDataStream stream(&result, QIODevice::WriteOnly | QIODevice::Append);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    stream << kVersion << linesPerBlock << static_cast<quint32>(blocks.size()) << linesCount;
+    quint32 offset = kHeaderSize + blocks.size() * kBlockRecordSize;
+    foreach (const Block &block, blocks)
+    {
+        stream << offset << block.compressedSize << block.originalSize << block.firstLine << (block.compressedCrc | static_cast<quint32>(block.originalCrc) << 16);
+        offset += block.compressedSize;
+    }
+    foreach (const QByteArray &compressedData, compressedBlocks)
+        result += compressedData;
+    return result;
+}
+
+bool ChunkedDataFile::open(const QString &path)
+{
+    close();
+    _file.setFileName(path);
+    if (!_file.open(QIODevice::ReadOnly))
+        return false;
+
+    if (uchar *mappedData = _file.map(0, _file.size()))
+        _data = QByteArray::fromRawData(reinterpret_cast<const char *>(mappedData), static_cast<int>(_file.size()));
+    else
+    {
+        _data = _file.readAll();
+        _file.close();
+    }
+    if (!readIndex())
+    {
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool ChunkedDataFile::setData(const QByteArray &fileData)
+{
+    close();
+    _data = fileData;
+    if (!readIndex())
+    {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void ChunkedDataFile::close()
+{
+    _data.clear(); // before unmapping
+    _blocks.clear();
+    _linesCount = 0;
+    if (_file.isOpen())
+        _file.close(); // unmaps the file
+}
+
+int ChunkedDataFile::blockOfLine(quint32 line) const
+{
+    if (line >= _linesCount)
+        return -1;
+
+    int first = 0, last = _blocks.size() - 1;
+    while (first < last)
+    {
+        int middle = (first + last + 1) / 2;
+        if (_blocks.at(middle).firstLine <= line)
+            first = middle;
+        else
+            last = middle - 1;
+    }
+    return first;
+}
+
+QByteArray ChunkedDataFile::blockText(int i) const
+{
+    const Block &block = _blocks.at(i);
+    const char *compressedData = _data.constData() + block.offset;
+    if (qChecksum(compressedData, block.compressedSize) != block.compressedCrc)
+        return QByteArray();
+
+    QByteArray originalData = qUncompress(reinterpret_cast<const uchar *>(compressedData), block.compressedSize);
+    if (static_cast<quint32>(originalData.size()) != block.originalSize || qChecksum(originalData.constData(), originalData.size()) != block.originalCrc)
+        return QByteArray();
+    return originalData.isNull() ? QByteArray("") : originalData;
+}
+
+QByteArray ChunkedDataFile::text(QList<int> *brokenBlocks /*= 0*/) const
+{
+    return blocksText(0, _blocks.size() - 1, brokenBlocks);
+}
+
+QByteArray ChunkedDataFile::lines(quint32 firstLine, quint32 count, QList<int> *brokenBlocks /*= 0*/) const
+{
+    int firstBlock = blockOfLine(firstLine);
+    if (firstBlock == -1 || !count)
+        return QByteArray();
+    int lastBlock = blockOfLine(qMin(firstLine + count, _linesCount) - 1);
+
+    QByteArray text = blocksText(firstBlock, lastBlock, brokenBlocks);
+    if (brokenBlocks && !brokenBlocks->isEmpty())
+        return text; // line numbers don't match the text anymore
+
+    int start = 0;
+    for (quint32 line = _blocks.at(firstBlock).firstLine; line < firstLine; ++line)
+        start = text.indexOf('\n', start) + 1;
+    int end = start;
+    for (quint32 i = 0; i < count && end < text.size(); ++i)
+    {
+        int lineEnd = text.indexOf('\n', end);
+        end = lineEnd == -1 ? text.size() : lineEnd + 1;
+    }
+    return text.mid(start, end - start);
+}
+
+bool ChunkedDataFile::readIndex()
+{
+    if (_data.size() < kHeaderSize || !isChunked(_data))
+        return false;
+
+    const uchar *data = reinterpret_cast<const uchar *>(_data.constData());
+    quint32 blocksCount = qFromLittleEndian<quint32>(data + 12);
+    if (qFromLittleEndian<quint32>(data + 4) != kVersion || kHeaderSize + static_cast<quint64>(blocksCount) * kBlockRecordSize > static_cast<quint64>(_data.size()))
+        return false;
+    _linesCount = qFromLittleEndian<quint32>(data + 16);
+
+    _blocks.reserve(blocksCount);
+    for (quint32 i = 0; i < blocksCount; ++i)
+    {
+        const uchar *record = data + kHeaderSize + i * kBlockRecordSize;
+        quint32 crcs = qFromLittleEndian<quint32>(record + 16);
+        Block block = { qFromLittleEndian<quint32>(record), qFromLittleEndian<quint32>(record + 4), qFromLittleEndian<quint32>(record + 8), qFromLittleEndian<quint32>(record + 12),
+                        static_cast<quint16>(crcs & 0xFFFF), static_cast<quint16>(crcs >> 16) };
+        if (static_cast<quint64>(block.offset) + block.compressedSize > static_cast<quint64>(_data.size()) || block.firstLine >= _linesCount || (i && block.firstLine <= _blocks.last().firstLine))
+            return false;
+        _blocks += block;
+    }
+    return true;
+}
+
+QByteArray ChunkedDataFile::blocksText(int firstBlock, int lastBlock, QList<int> *brokenBlocks) const
+{
+    QByteArray text;
+    quint32 size = 0;
+    for (int i = firstBlock; i <= lastBlock; ++i)
+        size += _blocks.at(i).originalSize;
+    text.reserve(size);
+
+    for (int i = firstBlock; i <= lastBlock; ++i)
+    {
+        QByteArray blockData = blockText(i);
+        if (blockData.isNull())
+        {
+            if (brokenBlocks)
+                *brokenBlocks += i;
+        }
+        else
+            text += blockData;
+    }
+    return text;
+}
@@ -0,0 +1,59 @@
+#ifndef CHUNKEDDATAFILE_H
+#define CHUNKEDDATAFILE_H
+
+#include <QFile>
+#include <QList>
+
+
+// Compressed text table in resources/data as utils/CompressFiles writes it. The text is split into blocks of whole lines
+// that are compressed independently, so blocks can be decompressed in parallel, a range of lines can be read without
+// decompressing the rest and a broken block doesn't take the whole table with it.
+// All numbers are little-endian quint32:
+//   header: magic 'MXLB', version, lines per block, blocks count, lines count
+//   index:  (offset from the file start, compressed size, original size, first line, CRC of compressed data | CRC of original data << 16) per block
+//   blocks: qCompress()'ed lines with their '\n'
+// Files without the magic have the legacy layout (2 CRCs followed by the whole text qCompress()'ed), see DataSnapshot::uncompressedData().
+class ChunkedDataFile
+{
+public:
+    struct Block
+    {
+        quint32 offset, compressedSize, originalSize, firstLine;
+        quint16 compressedCrc, originalCrc;
+    };
+
+    static const QByteArray kMagic;
+    static const quint32 kVersion, kDefaultLinesPerBlock;
+
+    static bool isChunked(const QByteArray &fileData) { return fileData.startsWith(kMagic); }
+    static QByteArray compressed(const QByteArray &text, quint32 linesPerBlock = kDefaultLinesPerBlock);
+
+    ChunkedDataFile() : _linesCount(0) {}
+
+    bool open(const QString &path); // maps the file and reads only the index, false if it's missing, broken or has the legacy layout
+    bool setData(const QByteArray &fileData); // the same for a file that is already read
+    void close();
+    bool isOpen() const { return !_data.isNull(); }
+
+    int blocksCount() const { return _blocks.size(); }
+    quint32 linesCount() const { return _linesCount; }
+    const Block &block(int i) const { return _blocks.at(i); }
+    int blockOfLine(quint32 line) const; // -1 if there's no such line
+
+    QByteArray blockText(int i) const; // null if the block is broken, can be called from several threads at once
+    QByteArray text(QList<int> *brokenBlocks = 0) const; // text of the intact blocks
+    QByteArray lines(quint32 firstLine, quint32 count, QList<int> *brokenBlocks = 0) const; // decompresses only the blocks having these lines
+
+private:
+    Q_DISABLE_COPY(ChunkedDataFile)
+
+    QFile _file; // open while it's mapped
+    QByteArray _data;
+    QList<Block> _blocks;
+    quint32 _linesCount;
+
+    bool readIndex();
+    QByteArray blocksText(int firstBlock, int lastBlock, QList<int> *brokenBlocks) const;
+};
+
+#endif // CHUNKEDDATAFILE_H
@@ -38,7 +38,7 @@ int main(int argc, char **argv)
 
     // Create minimal ItemInfo and set as Unique (special)
     ItemInfo *item = new ItemInfo();
-    item->itemType = code;
+    item->setItemType(code);
     item->quality = Enums::ItemQuality::Unique;
     item->isIdentified = true;
     item->isExtended = true;
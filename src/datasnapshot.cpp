@@ -0,0 +1,280 @@
+#include "datasnapshot.h"
+#include "chunkeddatafile.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QtEndian>
+
+#include <cstring>
+
+
+const quint32 DataSnapshot::kVersion = 2;
+const QByteArray DataSnapshot::kMagic("MXLS");
+
+static const int kHeaderSize = 20, kHashSize = 16, kTableRecordSize = 20 + kHashSize, kRecordSize = 8;
+
+QList<DataSnapshot::TableFile> DataSnapshot::tableFiles(const QString &locale)
+{
+    QList<TableFile> files;
+    foreach (const char *name, QList<const char *>() << "items" << "props" << "setitems" << "skills" << "uniques" << "monsters" << "rw" << "socketables" << "LowQualityItems")
+    {
+        TableFile file = { QString("%1/%2.dat").arg(locale, name), true };
+        files += file;
+    }
+    foreach (const char *name, QList<const char *>() << "string" << "patchstring" << "expansionstring") // string tables aren't compressed
+    {
+        TableFile file = { QString("%1/%2.dat").arg(locale, name), false };
+        files += file;
+    }
+    foreach (const char *name, QList<const char *>() << "itemtypes.dat" << "sets.dat")
+    {
+        TableFile file = { QString(name), true };
+        files += file;
+    }
+    return files;
+}
+
+// identical strings (mostly numbers) are stored once, '\0' after each one lets cells be used as C strings without a copy
+static quint32 poolOffset(const QByteArray &s, QByteArray *pool, QHash<QByteArray, quint32> *offsets)
+{
+    QHash<QByteArray, quint32>::const_iterator iter = offsets->constFind(s);
+    if (iter != offsets->constEnd())
+        return iter.value();
+
+    quint32 offset = pool->size();
+    pool->append(s).append('\0');
+    offsets->insert(s, offset);
+    return offset;
+}
+
+bool DataSnapshot::generate(const QString &dataPath, const QString &locale, const QString &snapshotPath, QString *error /*= 0*/)
+{
+    // the old snapshot may be mapped by someone else, so it's replaced only after the new one is complete.
+    // The file is created before the tables are read, an unwritable location shouldn't cost decompressing all of them
+    QString tempPath = snapshotPath + ".tmp";
+    QDir().mkpath(QFileInfo(snapshotPath).path());
+    QFile out(tempPath);
+    if (!out.open(QIODevice::WriteOnly))
+    {
+        if (error)
+            *error = QString("error creating file '%1': %2").arg(tempPath, out.errorString());
+        return false;
+    }
+
+    QByteArray tables, rows, cells, pool;
+    QDataStream tablesStream(&tables, QIODevice::WriteOnly), rowsStream(&rows, QIODevice::WriteOnly), cellsStream(&cells, QIODevice::WriteOnly);
+    tablesStream.setByteOrder(QDataStream::LittleEndian);
+    rowsStream.setByteOrder(QDataStream::LittleEndian);
+    cellsStream.setByteOrder(QDataStream::LittleEndian);
+
+    QHash<QByteArray, quint32> poolOffsets;
+    quint32 tablesCount = 0, rowsCount = 0, cellsCount = 0;
+    foreach (const TableFile &tableFile, tableFiles(locale))
+    {
+        QString path = QString("%1/%2").arg(dataPath, tableFile.fileName);
+        QFile f(path);
+        if (!f.open(QIODevice::ReadOnly))
+        {
+            if (error)
+                *error = QString("error opening file '%1': %2").arg(path, f.errorString());
+            out.remove();
+            return false;
+        }
+        QByteArray fileData = f.readAll(), text = tableFile.isCompressed ? uncompressedData(fileData) : fileData;
+        if (text.isNull())
+        {
+            if (error)
+                *error = QString("error decompressing file '%1'").arg(path);
+            out.remove();
+            return false;
+        }
+
+        DataTableRows tableRows = rowsFromText(text);
+        QByteArray name = tableFile.fileName.toUtf8(), hash = sourceHash(fileData);
+        tablesStream << poolOffset(name, &pool, &poolOffsets) << static_cast<quint32>(name.size()) << static_cast<quint32>(fileData.size());
+        tablesStream.writeRawData(hash.constData(), hash.size());
+        tablesStream << rowsCount << static_cast<quint32>(tableRows.size());
+        ++tablesCount;
+
+        foreach (const DataTableRow &row, tableRows)
+        {
+            rowsStream << cellsCount << static_cast<quint32>(row.size());
+            foreach (const QByteArray &cell, row)
+                cellsStream << poolOffset(cell, &pool, &poolOffsets) << static_cast<quint32>(cell.size());
+            cellsCount += row.size();
+        }
+        rowsCount += tableRows.size();
+    }
+
+    QByteArray header(kMagic);
+    QDataStream headerStream(&header, QIODevice::WriteOnly | QIODevice::Append);
+    headerStream.setByteOrder(QDataStream::LittleEndian);
+    headerStream << kVersion << tablesCount << rowsCount << cellsCount;
+
+    QByteArray snapshotData = header + tables + rows + cells + pool;
+    bool isWritten = out.write(snapshotData) == snapshotData.size();
+    out.close();
+    if (!isWritten || (QFile::exists(snapshotPath) && !QFile::remove(snapshotPath)) || !QFile::rename(tempPath, snapshotPath))
+    {
+        if (error)
+            *error = QString("error writing file '%1'").arg(snapshotPath);
+        QFile::remove(tempPath);
+        return false;
+    }
+    return true;
+}
+
+QByteArray DataSnapshot::uncompressedData(const QByteArray &compressedFileData)
+{
+    if (ChunkedDataFile::isChunked(compressedFileData))
+    {
+        ChunkedDataFile chunkedFile;
+        QList<int> brokenBlocks;
+        QByteArray text;
+        if (chunkedFile.setData(compressedFileData))
+            text = chunkedFile.text(&brokenBlocks);
+        return brokenBlocks.isEmpty() ? text : QByteArray();
+    }
+    if (compressedFileData.size() < 4)
+        return QByteArray();
+
+    const uchar *crcData = reinterpret_cast<const uchar *>(compressedFileData.constData());
+    quint16 compressedCrc = qFromLittleEndian<quint16>(crcData), originalCrc = qFromLittleEndian<quint16>(crcData + 2);
+    QByteArray compressedData = compressedFileData.mid(4);
+    if (qChecksum(compressedData.constData(), compressedData.length()) != compressedCrc)
+        return QByteArray();
+
+    QByteArray originalData = qUncompress(compressedData);
+    if (qChecksum(originalData.constData(), originalData.length()) != originalCrc)
+        return QByteArray();
+    return originalData;
+}
+
+DataTableRows DataSnapshot::rowsFromText(const QByteArray &text, bool canHaveHeader /*= true*/)
+{
+    DataTableRows rows;
+    for (int lineStart = 0; lineStart < text.size(); )
+    {
+        int lineEnd = text.indexOf('\n', lineStart);
+        if (lineEnd == -1)
+            lineEnd = text.size();
+
+        QByteArray line = text.mid(lineStart, lineEnd - lineStart).trimmed();
+        bool isFirstLine = canHaveHeader && lineStart == 0;
+        lineStart = lineEnd + 1;
+        if (!line.isEmpty() && !(isFirstLine && line.startsWith('#')))
+            rows += line.split('\t');
+    }
+    return rows;
+}
+
+bool DataSnapshot::open(const QString &path)
+{
+    close();
+    _buffer = ItemsBuffer::mapFile(path);
+    if (_buffer.size() < kHeaderSize || memcmp(_buffer.constData(), kMagic.constData(), kMagic.size()) || numberAt(4) != kVersion)
+    {
+        close();
+        return false;
+    }
+
+    quint32 tablesCount = numberAt(8), rowsCount = numberAt(12), cellsCount = numberAt(16);
+    quint64 rowsOffset = kHeaderSize + static_cast<quint64>(tablesCount) * kTableRecordSize, cellsOffset = rowsOffset + static_cast<quint64>(rowsCount) * kRecordSize,
+            poolOffset = cellsOffset + static_cast<quint64>(cellsCount) * kRecordSize;
+    if (poolOffset > static_cast<quint64>(_buffer.size()))
+    {
+        close();
+        return false;
+    }
+    _rowsOffset = rowsOffset;
+    _cellsOffset = cellsOffset;
+    _poolOffset = poolOffset;
+
+    quint64 poolSize = _buffer.size() - _poolOffset;
+    for (quint32 i = 0; i < tablesCount; ++i)
+    {
+        quint32 record = kHeaderSize + i * kTableRecordSize, nameOffset = numberAt(record), nameLength = numberAt(record + 4);
+        Table table = { numberAt(record + 8), QByteArray(_buffer.constData() + record + 12, kHashSize), numberAt(record + 12 + kHashSize), numberAt(record + 16 + kHashSize) };
+        if (static_cast<quint64>(nameOffset) + nameLength > poolSize || static_cast<quint64>(table.firstRow) + table.rowsCount > rowsCount)
+        {
+            close();
+            return false;
+        }
+        _tables[QString::fromUtf8(_buffer.constData() + _poolOffset + nameOffset, nameLength)] = table;
+    }
+    return true;
+}
+
+void DataSnapshot::close()
+{
+    _buffer = ItemsBuffer();
+    _tables.clear();
+    _rowsOffset = _cellsOffset = _poolOffset = 0;
+}
+
+bool DataSnapshot::isUpToDate(const QString &dataPath, const QString &locale) const
+{
+    foreach (const TableFile &tableFile, tableFiles(locale))
+    {
+        QHash<QString, Table>::const_iterator iter = _tables.constFind(tableFile.fileName);
+        if (iter == _tables.constEnd())
+            return false;
+
+        // the size rules out most changes without reading the file
+        QFile f(QString("%1/%2").arg(dataPath, tableFile.fileName));
+        if (!f.open(QIODevice::ReadOnly) || f.size() != iter.value().sourceSize || sourceHash(f.readAll()) != iter.value().sourceHash)
+            return false;
+    }
+    return true;
+}
+
+DataTableRows DataSnapshot::rows(const QString &fileName) const
+{
+    QHash<QString, Table>::const_iterator iter = _tables.constFind(fileName);
+    if (iter == _tables.constEnd())
+        return DataTableRows();
+
+    const Table &table = iter.value();
+    const char *pool = _buffer.constData() + _poolOffset;
+    quint64 poolSize = _buffer.size() - _poolOffset, cellsCount = (_poolOffset - _cellsOffset) / kRecordSize;
+
+    DataTableRows rows;
+    rows.reserve(table.rowsCount);
+    for (quint32 i = table.firstRow, n = table.firstRow + table.rowsCount; i < n; ++i)
+    {
+        quint32 firstCell = numberAt(_rowsOffset + i * kRecordSize), rowCellsCount = numberAt(_rowsOffset + i * kRecordSize + 4);
+        if (static_cast<quint64>(firstCell) + rowCellsCount > cellsCount)
+        {
+            qWarning("data snapshot row %u of '%s' is broken", i, qPrintable(fileName));
+            return DataTableRows();
+        }
+
+        DataTableRow row;
+        row.reserve(rowCellsCount);
+        for (quint32 j = firstCell, m = firstCell + rowCellsCount; j < m; ++j)
+        {
+            quint32 offset = numberAt(_cellsOffset + j * kRecordSize), length = numberAt(_cellsOffset + j * kRecordSize + 4);
+            if (static_cast<quint64>(offset) + length >= poolSize) // '\0' after the cell must be there too
+            {
+                qWarning("data snapshot cell %u of '%s' is broken", j, qPrintable(fileName));
+                return DataTableRows();
+            }
+            row += QByteArray::fromRawData(pool + offset, length);
+        }
+        rows += row;
+    }
+    return rows;
+}
+
+quint32 DataSnapshot::numberAt(quint32 offset) const
+{
+    return qFromLittleEndian<quint32>(reinterpret_cast<const uchar *>(_buffer.constData()) + offset);
+}
+
+QByteArray DataSnapshot::sourceHash(const QByteArray &fileData)
+{
+    return QCryptographicHash::hash(fileData, QCryptographicHash::Md5);
+}
@@ -0,0 +1,67 @@
+#ifndef DATASNAPSHOT_H
+#define DATASNAPSHOT_H
+
+#include "itembitbuffer.h"
+
+#include <QHash>
+#include <QStringList>
+
+
+typedef QList<QByteArray> DataTableRow;
+typedef QList<DataTableRow> DataTableRows;
+
+// Binary snapshot of the text tables ItemDataBase loads from resources/data, one file per locale kept in the cache directory.
+// Tables are stored already split into rows and cells, so loading them needs neither qUncompress() nor line splitting.
+// The file is memory-mapped, all numbers are little-endian quint32:
+//   header:  magic 'MXLS', version, tables count, rows count, cells count
+//   tables:  (name offset, name length, source file size, MD5 of the source file (16 bytes), first row, rows count)
+//   rows:    (first cell, cells count)
+//   cells:   (offset, length)
+//   string pool with table names and cell contents, each one followed by '\0', offsets above are relative to its start
+// A table is used only while its source file has the recorded size and hash, file times change on install and are ignored.
+class DataSnapshot
+{
+public:
+    struct TableFile
+    {
+        QString fileName; // relative to the data directory
+        bool isCompressed;
+    };
+
+    static const quint32 kVersion;
+    static const QByteArray kMagic;
+
+    static QList<TableFile> tableFiles(const QString &locale);
+    static QString fileName(const QString &locale) { return QString("%1/tables.snapshot").arg(locale); }
+    static bool generate(const QString &dataPath, const QString &locale, const QString &snapshotPath, QString *error = 0); // rewrites the snapshot from the table files
+
+    static QByteArray uncompressedData(const QByteArray &compressedFileData); // either layout written by utils/CompressFiles, null if a CRC doesn't match
+    static DataTableRows rowsFromText(const QByteArray &text, bool canHaveHeader = true); // non-empty tab-separated lines, first line is skipped if it starts with '#'
+
+    DataSnapshot() : _rowsOffset(0), _cellsOffset(0), _poolOffset(0) {}
+
+    bool open(const QString &path); // false if the file is missing, broken or has another version
+    void close();
+    bool isOpen() const { return !_buffer.isNull(); }
+    bool isUpToDate(const QString &dataPath, const QString &locale) const; // has every table and none of them changed
+
+    bool hasTable(const QString &fileName) const { return _tables.contains(fileName); }
+    DataTableRows rows(const QString &fileName) const; // cells point into the mapped file, so the snapshot must stay open while they're used
+
+private:
+    struct Table
+    {
+        quint32 sourceSize;
+        QByteArray sourceHash;
+        quint32 firstRow, rowsCount;
+    };
+
+    ItemsBuffer _buffer;
+    QHash<QString, Table> _tables;
+    quint32 _rowsOffset, _cellsOffset, _poolOffset;
+
+    quint32 numberAt(quint32 offset) const;
+    static QByteArray sourceHash(const QByteArray &fileData);
+};
+
+#endif // DATASNAPSHOT_H
@@ -40,7 +40,7 @@ int main(int argc, char **argv)
              << "isEthereal:" << it->isEthereal << "isPersonalized:" << it->isPersonalized << "isRW:" << it->isRW;
     qDebug() << "location:" << it->location << "whereEquipped:" << it->whereEquipped << "row:" << it->row << "column:" << it->column << "storage:" << it->storage;
     qDebug() << "guid:" << it->guid << "ilvl:" << it->ilvl << "quality:" << it->quality << "variableGraphicIndex:" << it->variableGraphicIndex;
-    qDebug() << "inscribedName:" << it->inscribedName << "defense:" << it->defense << "currentDurability:" << it->currentDurability << "maxDurability:" << it->maxDurability << "quantity:" << it->quantity << "socketsNumber:" << it->socketsNumber;
+    qDebug() << "inscribedName:" << it->rareInfo().inscribedName << "defense:" << it->defense << "currentDurability:" << it->currentDurability << "maxDurability:" << it->maxDurability << "quantity:" << it->quantity << "socketsNumber:" << it->socketsNumber;
     qDebug() << "bitString length:" << it->bitString.length();
 
     qDebug() << "Properties (id -> value, param, bitStringOffset):";
@@ -1,7 +1,9 @@
 #include "dupescandialog.h"
 #include "characterinfo.hpp"
 #include "itemparser.h"
+#include "itemview.h"
 #include "itemdatabase.h"
+#include "itemsviewerdialog.h"
 #include "enums.h"
 #include "propertiesdisplaymanager.h"
 #include "resourcepathmanager.hpp"
@@ -24,6 +26,9 @@
 #include <QFile>
 #include <QRegExp>
 #include <QTimer>
+#include <QSet>
+#include <QVector>
+#include <QtEndian>
 
 #ifndef QT_NO_DEBUG
 #include <QDebug>
@@ -40,23 +45,103 @@
 static const QLatin1String XmlFormat("xml"), JsonFormat("json");
 
 
-bool shouldCheckItem(ItemInfo *item)
+bool shouldCheckItem(const ItemHeader &item)
 {
     // ignore tomes, keys and non-magical quivers
-    return !(ItemDataBase::isTomeWithScrolls(item) || item->itemType == "key" || ((item->itemType == "aqv" || item->itemType == "cqv") && item->quality < Enums::ItemQuality::Magic));
+    ItemBase *base = ItemDataBase::itemBase(item.code);
+    QByteArray itemType = itemTypeFromCode(item.code);
+    return !((base && ItemParser::itemTypesInheritFromType(base->types, "book")) || itemType == "key" || ((itemType == "aqv" || itemType == "cqv") && item.quality < Enums::ItemQuality::Magic));
 }
 
-bool areItemsSame(ItemInfo *a, ItemInfo *b)
+// same text as ItemParser::itemStorageAndCoordinatesString()
+QString itemStorageAndCoordinatesString(const QString &text, const ItemHeader &item)
 {
-    return a->isExtended && a->guid == b->guid && a->itemType == b->itemType;
+    return text.arg(ItemsViewerDialog::tabNameAtIndex(ItemsViewerDialog::tabIndexFromItemStorage(item.storage))).arg(item.row + 1).arg(item.column + 1).arg(item.plugyPage ? item.plugyPage : static_cast<quint32>(item.whereEquipped));
 }
 
-QString dupedItemsStr(ItemInfo *item1, ItemInfo *item2)
+QString dupedItemsStr(const ItemHeader &item1, const ItemHeader &item2)
 {
-    return QString("<b>%1</b>: GUID 0x%2 (%3), type '%4', quality <b>%5</b>; %6; %7").arg(ItemDataBase::Items()->value(item1->itemType)->name)
-            .arg(item1->guid, 0, 16).arg(item1->guid).arg(item1->itemType.constData()).arg(metaEnumFromName<Enums::ItemQuality>("ItemQualityEnum").valueToKey(item1->quality))
-            .arg(ItemParser::itemStorageAndCoordinatesString("<font color=blue>ITEM1</font>: location %1, row %2, col %3, equipped in %4", item1))
-            .arg(ItemParser::itemStorageAndCoordinatesString("<font color=blue>ITEM2</font>: location %1, row %2, col %3, equipped in %4", item2));
+    ItemBase *base = ItemDataBase::itemBase(item1.code);
+    QByteArray itemType = itemTypeFromCode(item1.code);
+    return QString("<b>%1</b>: GUID 0x%2 (%3), type '%4', quality <b>%5</b>; %6; %7").arg(base ? base->name : QString(itemType))
+            .arg(item1.guid, 0, 16).arg(item1.guid).arg(itemType.constData()).arg(metaEnumFromName<Enums::ItemQuality>("ItemQualityEnum").valueToKey(item1.quality))
+            .arg(itemStorageAndCoordinatesString("<font color=blue>ITEM1</font>: location %1, row %2, col %3, equipped in %4", item1))
+            .arg(itemStorageAndCoordinatesString("<font color=blue>ITEM2</font>: location %1, row %2, col %3, equipped in %4", item2));
+}
+
+// top level items go to items, each one's socketables go to the same index of itemsSocketables
+bool appendItemHeaders(const ItemsBuffer &buffer, int *offset, int itemsTotal, int location, ItemHeaderTable *items, QVector<ItemHeaderTable> *itemsSocketables)
+{
+    for (int i = 0; i < itemsTotal; ++i)
+    {
+        ItemView view = ItemParser::parseItemView(buffer, *offset);
+        if (view.isNull())
+            return false;
+        *offset = view.offset() + view.bytesCount();
+
+        QList<ItemView> socketableViews;
+        if (!ItemParser::parseItemViews(buffer, offset, view.socketablesNumber(), &socketableViews))
+            return false;
+
+        ItemHeader header = ItemHeader::fromView(view);
+        if (location != -1)
+            header.location = location;
+        *items += header;
+
+        ItemHeaderTable socketables;
+        foreach (const ItemView &socketableView, socketableViews)
+            socketables += ItemHeader::fromView(socketableView);
+        *itemsSocketables += socketables;
+    }
+    return true;
+}
+
+// Character, mercenary and iron golem items of a .d2s file, found the same way MedianXLOfflineTools::processSaveFile() finds them
+// but read only as headers from the mapped file. False if an item can't be read by its structure, such file has to be loaded.
+bool readCharacterItemHeaders(const QString &path, ItemHeaderTable *items, QVector<ItemHeaderTable> *itemsSocketables)
+{
+    ItemsBuffer buffer = ItemsBuffer::mapFile(path);
+    QByteArray bytes = buffer.toByteArray();
+    if (bytes.size() <= Enums::Offsets::StatsData || bytes.mid(Enums::Offsets::StatsHeader, 2) != "gf")
+        return false;
+
+    // "if" can occur in stats too, skills start at the last one before the first item header after it
+    int skillsOffset = bytes.indexOf("if", Enums::Offsets::StatsData), firstItemOffset = bytes.indexOf(ItemParser::kItemHeader, skillsOffset);
+    if (skillsOffset == -1 || firstItemOffset == -1)
+        return false;
+    for (int nextOffset = skillsOffset; nextOffset != -1 && nextOffset < firstItemOffset; nextOffset = bytes.indexOf("if", nextOffset + 1))
+        skillsOffset = nextOffset;
+
+    const uchar *data = reinterpret_cast<const uchar *>(bytes.constData());
+    int offset = skillsOffset + 2 + data[Enums::Offsets::SkillsCount];
+    if (bytes.mid(offset, ItemParser::kItemHeader.size()) != ItemParser::kItemHeader || offset + 4 > bytes.size())
+        return false;
+    int charItemsTotal = qFromLittleEndian<quint16>(data + offset + 2);
+    offset += 4;
+    if (!appendItemHeaders(buffer, &offset, charItemsTotal, -1, items, itemsSocketables))
+        return false;
+
+    // JM + number of corpses (always 0 in Sigma), then the mercenary header
+    if (bytes.mid(offset, ItemParser::kItemHeader.size()) != ItemParser::kItemHeader || bytes.mid(offset + 4, 2) != "jf")
+        return false;
+    offset += 6;
+    if (qFromLittleEndian<quint32>(data + Enums::Offsets::Mercenary))
+    {
+        if (bytes.mid(offset, ItemParser::kItemHeader.size()) != ItemParser::kItemHeader || offset + 4 > bytes.size())
+            return false;
+        int mercItemsTotal = qFromLittleEndian<quint16>(data + offset + 2);
+        offset += 4;
+        if (!appendItemHeaders(buffer, &offset, mercItemsTotal, Enums::ItemLocation::Merc, items, itemsSocketables))
+            return false;
+    }
+
+    if (bytes.mid(offset, 2) != "kf" || offset + 2 >= bytes.size())
+        return false;
+    offset += 2;
+    if (bytes.at(offset) <= 0) // no iron golem
+        return true;
+    ++offset;
+    return appendItemHeaders(buffer, &offset, 1, Enums::ItemLocation::IronGolem, items, itemsSocketables);
 }
 
 QString addBool(const QString &s, bool b) { return s + QLatin1String(b ? "1" : "0"); }
@@ -80,17 +165,21 @@ QString crossCompareItems(const CrossCompareTask &task)
         if (!task.skipEmptyResults)
             result += "<br>" + iter.key();
 
-        const ItemsList &iItems = iter.value();
+        // shouldCheckItem() looks up the item base, so it's called only for the matches
+        const ItemHeaderTable &iItems = iter.value();
         for (ItemsHashIterator jter = iter + 1; jter != task.end; ++jter)
         {
             isFirst = true;
-            foreach (ItemInfo *iItem, iItems)
+            const ItemHeaderTable &jItems = jter.value();
+            for (int i = 0; i < iItems.size(); ++i)
             {
-                if (iItem->isExtended && shouldCheckItem(iItem))
+                const ItemHeader &iItem = iItems.at(i);
+                if (iItem.hasFlag(ItemHeader::Extended))
                 {
-                    foreach (ItemInfo *jItem, jter.value())
+                    for (int j = 0; j < jItems.size(); ++j)
                     {
-                        if (areItemsSame(jItem, iItem))
+                        const ItemHeader &jItem = jItems.at(j);
+                        if (jItem.isSameItemAs(iItem) && shouldCheckItem(iItem))
                         {
                             if (!dupedItemFound && task.skipEmptyResults)
                             {
@@ -213,12 +302,6 @@ DupeScanDialog::DupeScanDialog(const QString &currentPath, bool isDumpItemsMode,
         QTimer::singleShot(0, this, SLOT(scan()));
 }
 
-DupeScanDialog::~DupeScanDialog()
-{
-    foreach (const ItemsList &items, _allItemsHash)
-        qDeleteAll(items);
-}
-
 void DupeScanDialog::done(int r)
 {
     if (_futureWatcher)
@@ -268,8 +351,6 @@ void DupeScanDialog::scanFinished_()
 {
     if (!_isDumpItemsMode)
     {
-        foreach (const ItemsList &items, _allItemsHash)
-            qDeleteAll(items);
         _allItemsHash.clear();
 
         _logBrowser->append(QString("<font color=black>processing took %1 seconds in total</font>").arg(_timeCounter.elapsed() / 1000));
@@ -347,6 +428,9 @@ void DupeScanDialog::scanCharactersInDir(const QString &path)
 
         QString fileName = fileInfo.fileName(), header = _isDumpItemsMode ? ("processing " + fileName) : (fileName + " dupe stats");
         qDebug("loading %s", qPrintable(fileName));
+        ItemHeaderTable items;
+        QVector<ItemHeaderTable> itemsSocketables;
+        bool isLoaded = true;
         if (isFirst)
         {
             header += " (currently loaded)";
@@ -361,7 +445,14 @@ void DupeScanDialog::scanCharactersInDir(const QString &path)
                 continue;
             }
 
-            emit loadFile(path);
+            // the dupe check needs only GUID, type and location, so the file is loaded only if its items can't be read by their structure
+            isLoaded = _isDumpItemsMode || !readCharacterItemHeaders(path, &items, &itemsSocketables);
+            if (isLoaded)
+            {
+                items.clear();
+                itemsSocketables.clear();
+                emit loadFile(path);
+            }
         }
         if (!_skipEmptyCheckBox->isChecked() || !_loadingMessage.isEmpty())
         {
@@ -500,7 +591,7 @@ void DupeScanDialog::scanCharactersInDir(const QString &path)
                 {
                     foreach (ItemInfo *socketable, item->socketablesInfo)
                     {
-                        if (ItemParser::itemTypesInheritFromType(ItemDataBase::Items()->value(socketable->itemType)->types, "erun"))
+                        if (ItemParser::itemTypesInheritFromType(ItemDataBase::itemBase(socketable->itemCode())->types, "erun"))
                         {
                             keyValue[QLatin1String("isEnhancedRW")] = QLatin1String("1");
                             break;
@@ -550,32 +641,43 @@ void DupeScanDialog::scanCharactersInDir(const QString &path)
         }
         else
         {
-            ItemsList itemsAndSocketables = ci.items.character, checkedItems;
-            for (int i = 0; i < itemsAndSocketables.size() - 1; ++i)
+            if (isLoaded)
             {
-                ItemInfo *iItem = itemsAndSocketables.at(i);
-                if (iItem->isExtended && shouldCheckItem(iItem))
+                foreach (ItemInfo *item, ci.items.character)
                 {
-                    itemsAndSocketables << iItem->socketablesInfo;
+                    items += ItemHeader::fromItem(item);
+                    ItemHeaderTable socketables;
+                    foreach (ItemInfo *socketable, item->socketablesInfo)
+                        socketables += ItemHeader::fromItem(socketable);
+                    itemsSocketables += socketables;
+                }
+            }
 
-                    bool alreadyChecked = false;
-                    foreach (ItemInfo *item, checkedItems)
-                    {
-                        if (iItem->guid == item->guid)
-                        {
-                            alreadyChecked = true;
-                            break;
-                        }
-                    }
-                    if (alreadyChecked)
-                        continue;
+            // socketables are appended while the list is walked, so an item is compared only with what was in the list at its turn,
+            // and the last item is neither checked nor has its socketables added
+            QVector<bool> shouldCheck;
+            QVector<int> comparedCount;
+            for (int i = 0; i < items.size() - 1; ++i)
+            {
+                ItemHeader item = items.at(i);
+                shouldCheck += item.hasFlag(ItemHeader::Extended) && shouldCheckItem(item);
+                if (shouldCheck.last() && i < itemsSocketables.size())
+                    items += itemsSocketables.at(i);
+                comparedCount += items.size();
+            }
 
-                    for (int j = i + 1; j < itemsAndSocketables.size(); ++j)
+            QSet<quint32> dupedGuids;
+            for (int i = 0; i < items.size() - 1; ++i)
+            {
+                const ItemHeader &iItem = items.at(i);
+                if (shouldCheck.at(i) && !dupedGuids.contains(iItem.guid))
+                {
+                    for (int j = i + 1; j < comparedCount.at(i); ++j)
                     {
-                        ItemInfo *jItem = itemsAndSocketables.at(j);
-                        if (areItemsSame(jItem, iItem))
+                        const ItemHeader &jItem = items.at(j);
+                        if (jItem.isSameItemAs(iItem))
                         {
-                            checkedItems += iItem;
+                            dupedGuids.insert(iItem.guid);
                             if (!dupedItemFound && _skipEmptyCheckBox->isChecked())
                             {
                                 appendStringToLog(header + "\n");
@@ -586,15 +688,7 @@ void DupeScanDialog::scanCharactersInDir(const QString &path)
                     }
                 }
             }
-
-            ItemsList itemsCopy;
-            foreach (ItemInfo *item, itemsAndSocketables)
-            {
-                ItemInfo *itemCopy = new ItemInfo(*item);
-                itemCopy->shouldDeleteEverything = false; // because it's a shallow copy
-                itemsCopy += itemCopy;
-            }
-            _allItemsHash[fileName] = itemsCopy;
+            _allItemsHash[fileName] = items;
         }
 
         if (!_isDumpItemsMode && (!_skipEmptyCheckBox->isChecked() || dupedItemFound || !_loadingMessage.isEmpty()))
@@ -652,7 +746,7 @@ QVariantMap DupeScanDialog::keyValueFromItem(ItemInfo *item)
     if (nameList.size() > 1)
         keyValue[QLatin1String("name_special")] = nameList.first();
 
-    ItemBase *baseInfo = ItemDataBase::Items()->value(item->itemType);
+    ItemBase *baseInfo = ItemDataBase::itemBase(item->itemCode());
     QString imageName;
     if (item->quality == Enums::ItemQuality::Unique || item->quality == Enums::ItemQuality::Set)
     {
@@ -4,7 +4,7 @@
 #include <QDialog>
 #include <QFutureWatcher>
 #include <QTime>
-#include "structs.h"
+#include "itemheader.h"
 
 class QLineEdit;
 class QTextEdit;
@@ -13,7 +13,7 @@ class QCheckBox;
 class QProgressBar;
 class IKeyValueWriter;
 
-typedef QHash<QString, ItemsList> ItemsHash;
+typedef QHash<QString, ItemHeaderTable> ItemsHash;
 typedef ItemsHash::const_iterator ItemsHashIterator;
 
 class DupeScanDialog : public QDialog
@@ -22,7 +22,6 @@ class DupeScanDialog : public QDialog
 
 public:
     DupeScanDialog(const QString &currentPath = QString(), bool isDumpItemsMode = false, QWidget *parent = 0);
-    virtual ~DupeScanDialog();
 
     void logLoadingError(const QString &error, bool warn) { _loadingMessage = QString("<font color=%1>%2</font>").arg(warn ? "yellow" : "red", error); }
 
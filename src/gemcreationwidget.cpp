@@ -328,7 +328,7 @@ ItemInfo* GemCreationWidget::createGemItem(const QString &gemCode)
         // Update itemType to match selected gem if needed
         if (gem->itemType != gemCode.toUtf8()) {
             qDebug() << "Updating itemType from" << gem->itemType << "to" << gemCode;
-            gem->itemType = gemCode.toUtf8();
+            gem->setItemType(gemCode.toUtf8());
             
             // Update itemType in bitString using the same method as runes
             for (int i = 0; i < gem->itemType.length() && i < 4; i++) {
@@ -462,7 +462,7 @@ ItemInfo* GemCreationWidget::createBasicGem(const QString &gemCode)
         gem->whereEquipped = 0;
         gem->shouldDeleteEverything = true;
         
-        gem->itemType = gemCode.toUtf8();
+        gem->setItemType(gemCode.toUtf8());
         gem->quality = 2; // Normal quality
         gem->socketsNumber = 0;
         gem->socketablesNumber = 0;
@@ -17,7 +17,7 @@
 
 bool isRWInGear(ItemInfo *item, const QByteArray &rune, const QByteArray &allowedItemType)
 {
-    if (item->isRW && item->location == Enums::ItemLocation::Equipped && ItemParser::itemTypesInheritFromType(ItemDataBase::Items()->value(item->itemType)->types, allowedItemType))
+    if (item->isRW && item->location == Enums::ItemLocation::Equipped && ItemParser::itemTypesInheritFromType(ItemDataBase::itemBase(item->itemCode())->types, allowedItemType))
     {
         const RunewordHash *const rwHash = ItemDataBase::RW();
         for (RunewordHash::const_iterator iter = rwHash->find(rune); iter != rwHash->end() && iter.key() == rune; ++iter)
@@ -189,7 +189,7 @@ void customizeItemsTreeView(QTreeView *treeView)
 qint32 getValueOfPropertyInItem(ItemInfo *item, quint16 propKey, quint16 param /*= 0*/)
 {
     qint32 result = 0;
-    foreach (const PropertiesMultiMap *const props, QList<PropertiesMultiMap *>() << &item->props << &item->rwProps/* << &item->setProps*/)
+    foreach (const PropertiesMultiMap *const props, QList<PropertiesMultiMap *>() << &item->props.map() << &item->rwProps.map()/* << &item->setProps*/)
         foreach (ItemProperty *itemProp, props->values(propKey))
             if (itemProp->param == param)
                 result += itemProp->value;
@@ -219,7 +219,7 @@ bool isInExternalStorage(ItemInfo* item)
 
 bool isTiered(ItemInfo *item)
 {
-    return isTiered(ItemDataBase::Items()->value(item->itemType)->types);
+    return isTiered(ItemDataBase::itemBase(item->itemCode())->types);
 }
 
 bool isTiered(const QList<QByteArray> &itemTypes)
@@ -347,7 +347,7 @@ bool isArcaneShard4(ItemInfo *item)
 
 bool isShrineVessel(ItemInfo *item)
 {
-    return ItemDataBase::Items()->value(item->itemType)->types.contains("shco");
+    return ItemDataBase::itemBase(item->itemCode())->types.contains("shco");
 }
 
 
@@ -365,7 +365,7 @@ bool compareItemsByRlvl(ItemInfo *a, ItemInfo *b)
                 return ua->ilvl < ub->ilvl;
         return a->setOrUniqueId < b->setOrUniqueId;
     }
-    return ItemDataBase::Items()->value(a->itemType)->rlvl < ItemDataBase::Items()->value(b->itemType)->rlvl;
+    return ItemDataBase::itemBase(a->itemCode())->rlvl < ItemDataBase::itemBase(b->itemCode())->rlvl;
 }
 
 bool compareItemsByRlvlAndEthereality(ItemInfo *a, ItemInfo *b)
@@ -374,7 +374,7 @@ bool compareItemsByRlvlAndEthereality(ItemInfo *a, ItemInfo *b)
     if (areBothItemsSetOrUnique(a, b) && isSacred(a) && isSacred(b))
         return a->setOrUniqueId == b->setOrUniqueId ? ethCompareResult : compareItemsByRlvl(a, b);
 
-    quint16 aRlvl = ItemDataBase::Items()->value(a->itemType)->rlvl, bRlvl = ItemDataBase::Items()->value(b->itemType)->rlvl;
+    quint16 aRlvl = ItemDataBase::itemBase(a->itemCode())->rlvl, bRlvl = ItemDataBase::itemBase(b->itemCode())->rlvl;
     return aRlvl == bRlvl ? ethCompareResult : aRlvl < bRlvl;
 }
 
@@ -0,0 +1,329 @@
+#include "itembitbuffer.h"
+
+#include <QFile>
+
+#include <cstring>
+
+
+ItemsBuffer ItemsBuffer::mapFile(const QString &path)
+{
+    QSharedPointer<QFile> file(new QFile(path));
+    if (!file->open(QIODevice::ReadOnly))
+        return ItemsBuffer();
+
+    ItemsBuffer buffer;
+    if (uchar *data = file->size() ? file->map(0, file->size()) : 0)
+    {
+        buffer._mappedFile = file;
+        buffer._mappedData = reinterpret_cast<const char *>(data);
+        buffer._mappedSize = file->size();
+        return buffer;
+    }
+    return ItemsBuffer(file->readAll());
+}
+
+
+const int ItemBitBuffer::kBitsInWord;
+
+ItemBitBuffer ItemBitBuffer::fromBytes(const char *data, int length)
+{
+    ItemBitBuffer buffer;
+    buffer._size = length * 8;
+    buffer._words.fill(0, wordsForBits(buffer._size));
+
+    quint64 *words = buffer._words.data();
+    for (int i = 0; i < length; ++i)
+        words[i / 8] |= static_cast<quint64>(static_cast<quint8>(data[i])) << (i % 8 * 8);
+    return buffer;
+}
+
+ItemBitBuffer ItemBitBuffer::fromBytes(const QByteArray &bytes)
+{
+    return fromBytes(bytes.constData(), bytes.size());
+}
+
+ItemBitBuffer ItemBitBuffer::fromBuffer(const ItemsBuffer &buffer, int offset, int length)
+{
+    ItemBitBuffer bits;
+    bits._size = length * 8;
+    if (length)
+    {
+        bits._shared = buffer;
+        bits._sharedOffset = offset;
+    }
+    return bits;
+}
+
+quint64 ItemBitBuffer::bitsFromBytes(const char *data, int pos, int length)
+{
+    const uchar *bytes = reinterpret_cast<const uchar *>(data) + pos / 8;
+    int shift = pos % 8, bytesCount = (shift + length + 7) / 8;
+
+    quint64 value = 0;
+    for (int i = qMin(bytesCount, 8) - 1; i >= 0; --i)
+        value = (value << 8) | bytes[i];
+    value >>= shift;
+    if (bytesCount > 8) // 64 bits starting in the middle of a byte
+        value |= static_cast<quint64>(bytes[8]) << (kBitsInWord - shift);
+    return value & lowBitsMask(length);
+}
+
+void ItemBitBuffer::detach()
+{
+    if (!isShared())
+        return;
+
+    _words = fromBytes(sharedData(), bytesCount())._words;
+    _shared = ItemsBuffer();
+    _sharedOffset = 0;
+}
+
+void ItemBitBuffer::clear()
+{
+    _words.clear();
+    _shared = ItemsBuffer();
+    _sharedOffset = 0;
+    _size = 0;
+    _hasPendingEdits = false;
+    _pieces.clear();
+    _insertedBits.clear();
+}
+
+void ItemBitBuffer::resize(int newSize)
+{
+    detach();
+    compact();
+    if (newSize < 0)
+        newSize = 0;
+    if (newSize < _size)
+    {
+        _words.resize(wordsForBits(newSize));
+        if (int usedBits = newSize % kBitsInWord)
+            _words.last() &= lowBitsMask(usedBits);
+    }
+    else
+    {
+        for (int i = _words.size(), n = wordsForBits(newSize); i < n; ++i)
+            _words.append(0);
+    }
+    _size = newSize;
+}
+
+quint64 ItemBitBuffer::bits(int pos, int length) const
+{
+    if (isShared())
+        return bitsFromBytes(sharedData(), pos, length);
+
+    compact();
+    int wordIndex = pos / kBitsInWord, shift = pos % kBitsInWord;
+    quint64 value = _words.at(wordIndex) >> shift;
+    if (shift + length > kBitsInWord)
+        value |= _words.at(wordIndex + 1) << (kBitsInWord - shift);
+    return value & lowBitsMask(length);
+}
+
+void ItemBitBuffer::setBits(int pos, int length, quint64 value)
+{
+    detach();
+    compact();
+    value &= lowBitsMask(length);
+
+    quint64 *words = _words.data();
+    int wordIndex = pos / kBitsInWord, shift = pos % kBitsInWord;
+    words[wordIndex] = (words[wordIndex] & ~(lowBitsMask(length) << shift)) | (value << shift);
+    if (shift + length > kBitsInWord)
+    {
+        int highBits = shift + length - kBitsInWord;
+        words[wordIndex + 1] = (words[wordIndex + 1] & ~lowBitsMask(highBits)) | (value >> (kBitsInWord - shift));
+    }
+}
+
+void ItemBitBuffer::appendBits(quint64 value, int length)
+{
+    if (length <= 0)
+        return;
+
+    int pos = _size;
+    resize(_size + length);
+    setBits(pos, length, value);
+}
+
+void ItemBitBuffer::appendRange(const ItemBitBuffer &other, int pos, int length)
+{
+    if (&other == this)
+    {
+        ItemBitBuffer copy(other);
+        appendRange(copy, pos, length);
+        return;
+    }
+
+    other.compact();
+    reserve(_size + length);
+    for (int end = pos + length; pos < end; pos += kBitsInWord)
+    {
+        int chunk = qMin(kBitsInWord, end - pos);
+        appendBits(other.bits(pos, chunk), chunk);
+    }
+}
+
+void ItemBitBuffer::insert(int pos, const ItemBitBuffer &other)
+{
+    if (other.isEmpty())
+        return;
+    pos = qBound(0, pos, _size);
+
+    startEditing();
+    _insertedBits += other;
+    Piece piece = { _insertedBits.size() - 1, 0, other._size };
+    _pieces.insert(splitPieceAt(pos), piece);
+    _size += other._size;
+}
+
+void ItemBitBuffer::remove(int pos, int length)
+{
+    if (pos < 0 || length <= 0 || pos >= _size)
+        return;
+    length = qMin(length, _size - pos);
+
+    startEditing();
+    int first = splitPieceAt(pos), last = splitPieceAt(pos + length);
+    _pieces.remove(first, last - first);
+    _size -= length;
+}
+
+void ItemBitBuffer::startEditing()
+{
+    if (_hasPendingEdits)
+        return;
+
+    detach();
+    _hasPendingEdits = true;
+    _baseSize = _size;
+    if (_size)
+    {
+        Piece base = { -1, 0, _size };
+        _pieces += base;
+    }
+}
+
+// returns index of the piece starting at pos, splitting the piece that contains it if needed
+int ItemBitBuffer::splitPieceAt(int pos)
+{
+    for (int i = 0, start = 0; i < _pieces.size(); start += _pieces.at(i++).length)
+    {
+        if (pos == start)
+            return i;
+        Piece &piece = _pieces[i];
+        if (pos < start + piece.length)
+        {
+            Piece tail = { piece.source, piece.pos + pos - start, start + piece.length - pos };
+            piece.length = pos - start;
+            _pieces.insert(i + 1, tail);
+            return i + 1;
+        }
+    }
+    return _pieces.size();
+}
+
+void ItemBitBuffer::applyPendingEdits() const
+{
+    ItemBitBuffer base;
+    base._words = _words;
+    base._size = _baseSize;
+
+    ItemBitBuffer result;
+    result.reserve(_size);
+    foreach (const Piece &piece, _pieces)
+        result.appendRange(piece.source == -1 ? base : _insertedBits.at(piece.source), piece.pos, piece.length);
+
+    _words = result._words;
+    _hasPendingEdits = false;
+    _pieces.clear();
+    _insertedBits.clear();
+}
+
+void ItemBitBuffer::writeBytes(char *dest) const
+{
+    compact();
+    // the string writer cut 8-char chunks from the highest bits down, so an incomplete chunk became the first byte
+    if (int headBits = _size % 8)
+    {
+        *dest++ = static_cast<char>(bits(0, headBits));
+        for (int pos = headBits; pos < _size; pos += 8)
+            *dest++ = static_cast<char>(bits(pos, 8));
+        return;
+    }
+
+    if (isShared())
+    {
+        memcpy(dest, sharedData(), bytesCount());
+        return;
+    }
+    const quint64 *words = _words.constData();
+    for (int i = 0, n = bytesCount(); i < n; ++i)
+        dest[i] = static_cast<char>(words[i / 8] >> (i % 8 * 8));
+}
+
+bool ItemBitBuffer::operator==(const ItemBitBuffer &other) const
+{
+    if (_size != other._size)
+        return false;
+    if (!isShared() && !other.isShared())
+    {
+        compact();
+        other.compact();
+        return _words == other._words;
+    }
+
+    for (int pos = 0; pos < _size; pos += kBitsInWord)
+    {
+        int length = qMin(kBitsInWord, _size - pos);
+        if (bits(pos, length) != other.bits(pos, length))
+            return false;
+    }
+    return true;
+}
+
+QByteArray ItemBitBuffer::toBytes() const
+{
+    QByteArray bytes;
+    bytes.resize(bytesCount());
+    writeBytes(bytes.data());
+    return bytes;
+}
+
+
+QString ItemBitBuffer::toBitString() const
+{
+    return mid(0);
+}
+
+ItemBitBuffer &ItemBitBuffer::operator=(const QString &bitString)
+{
+    clear();
+    _size = bitString.length();
+    _words.fill(0, wordsForBits(_size));
+
+    quint64 *words = _words.data();
+    const QChar *chars = bitString.constData();
+    for (int pos = 0; pos < _size; ++pos)
+        if (chars[_size - 1 - pos] == QLatin1Char('1'))
+            words[pos / kBitsInWord] |= Q_UINT64_C(1) << (pos % kBitsInWord);
+    return *this;
+}
+
+QString ItemBitBuffer::mid(int position, int n /*= -1*/) const
+{
+    if (position < 0 || position >= _size)
+        return QString();
+    if (n < 0 || position + n > _size)
+        n = _size - position;
+
+    compact();
+    QString result(n, QLatin1Char('0'));
+    QChar *chars = result.data();
+    for (int i = 0, pos = _size - 1 - position; i < n; ++i, --pos)
+        if (testBit(pos))
+            chars[i] = QLatin1Char('1');
+    return result;
+}
@@ -0,0 +1,131 @@
+#ifndef ITEMBITBUFFER_H
+#define ITEMBITBUFFER_H
+
+#include <QVector>
+#include <QList>
+#include <QString>
+#include <QByteArray>
+#include <QSharedPointer>
+
+
+class QFile;
+
+// Bytes of a loaded file that item bits are read from without copying: an implicitly shared QByteArray
+// or a memory-mapped file that stays mapped while any copy of the buffer exists.
+// A mapped file must not be overwritten while it's in use, so files that can be saved back are read into QByteArray.
+class ItemsBuffer
+{
+public:
+    ItemsBuffer() : _mappedData(0), _mappedSize(0) {}
+    explicit ItemsBuffer(const QByteArray &bytes) : _bytes(bytes), _mappedData(0), _mappedSize(0) {} // bytes mustn't be QByteArray::fromRawData()
+
+    static ItemsBuffer mapFile(const QString &path); // reads the file if it can't be mapped, isNull() if it can't be opened
+
+    bool isNull() const { return !isMapped() && _bytes.isNull(); }
+    bool isMapped() const { return !_mappedFile.isNull(); }
+    const char *constData() const { return isMapped() ? _mappedData : _bytes.constData(); }
+    int size() const { return isMapped() ? _mappedSize : _bytes.size(); }
+    QByteArray toByteArray() const { return isMapped() ? QByteArray::fromRawData(_mappedData, _mappedSize) : _bytes; } // valid while this buffer exists
+
+private:
+    QByteArray _bytes;
+    QSharedPointer<QFile> _mappedFile;
+    const char *_mappedData;
+    int _mappedSize;
+};
+
+
+// Packed item bits stored in 64-bit words.
+// Bit 0 is the least significant bit of the first byte after 'JM', so positions are the same as
+// ReverseBitReader::pos() and Enums::ItemOffsets values without the 16 'JM' bits.
+// The legacy '0'/'1' string keeps the same bits in reverse order (string index 0 is the highest bit),
+// the QString-like methods at the bottom work in that order for the code that still expects it.
+// insert() and remove() only record the edit, the bits are rebuilt in one pass when they're needed next.
+// A buffer made with fromBuffer() reads the shared file bytes and copies them only when it's changed.
+// Const methods may apply the pending edits, so a buffer can't be used from several threads at once even for reading,
+// the parallel stash page parsing gives every thread its own items and only shares the read-only file bytes.
+class ItemBitBuffer
+{
+public:
+    static const int kBitsInWord = 64;
+
+    ItemBitBuffer() : _size(0), _hasPendingEdits(false), _baseSize(0), _sharedOffset(0) {}
+    explicit ItemBitBuffer(const QString &bitString) : _size(0), _hasPendingEdits(false), _baseSize(0), _sharedOffset(0) { *this = bitString; }
+
+    static ItemBitBuffer fromBytes(const char *data, int length);
+    static ItemBitBuffer fromBytes(const QByteArray &bytes);
+    static ItemBitBuffer fromBuffer(const ItemsBuffer &buffer, int offset, int length); // no copy, length is in bytes
+    static quint64 bitsFromBytes(const char *data, int pos, int length); // 0 < length <= 64, reads only the bytes containing the bits
+
+    int size() const { return _size; }
+    bool isEmpty() const { return !_size; }
+    void clear();
+    void reserve(int bitsCount) { detach(); compact(); _words.reserve(wordsForBits(bitsCount)); }
+    void resize(int newSize);
+    bool isShared() const { return !_shared.isNull(); }
+    const char *sharedBytes() const { return isShared() ? sharedData() : 0; } // file bytes the bits are still read from, 0 after they're copied
+
+    bool testBit(int pos) const
+    {
+        if (isShared())
+            return bitsFromBytes(sharedData(), pos, 1);
+        compact();
+        return (_words.at(pos / kBitsInWord) >> (pos % kBitsInWord)) & 1;
+    }
+    quint64 bits(int pos, int length) const; // 0 < length <= 64
+    void setBits(int pos, int length, quint64 value);
+
+    void appendBits(quint64 value, int length);
+    void append(const ItemBitBuffer &other) { appendRange(other, 0, other._size); }
+    void appendRange(const ItemBitBuffer &other, int pos, int length);
+    void insert(int pos, const ItemBitBuffer &other);
+    void remove(int pos, int length);
+    bool hasPendingEdits() const { return _hasPendingEdits; }
+    void compact() const { if (_hasPendingEdits) applyPendingEdits(); }
+
+    int bytesCount() const { return (_size + 7) / 8; }
+    void writeBytes(char *dest) const; // writes bytesCount() bytes, if size() isn't a multiple of 8 the first byte holds the lowest size() % 8 bits
+    QByteArray toBytes() const;
+
+    bool operator==(const ItemBitBuffer &other) const;
+    bool operator!=(const ItemBitBuffer &other) const { return !(*this == other); }
+
+    // legacy bit string interface
+    QString toBitString() const;
+    operator QString() const { return toBitString(); }
+    ItemBitBuffer &operator=(const QString &bitString);
+
+    int length() const { return _size; }
+    QChar at(int i) const { return testBit(_size - 1 - i) ? QChar('1') : QChar('0'); }
+    QString mid(int position, int n = -1) const;
+    QString left(int n) const { return mid(0, n); }
+    int indexOf(const QString &s, int from = 0) const { return toBitString().indexOf(s, from); }
+    bool contains(const QString &s) const { return indexOf(s) != -1; }
+
+private:
+    // a run of bits in the edited buffer: source -1 is _words before the edits, otherwise an index in _insertedBits
+    struct Piece
+    {
+        int source, pos, length;
+    };
+
+    mutable QVector<quint64> _words; // bits past _size (or _baseSize while edits are pending) are always 0
+    int _size;
+    mutable bool _hasPendingEdits;
+    mutable int _baseSize;
+    mutable QVector<Piece> _pieces;
+    mutable QList<ItemBitBuffer> _insertedBits;
+    ItemsBuffer _shared; // _words is empty while the bits are read from here
+    int _sharedOffset;
+
+    const char *sharedData() const { return _shared.constData() + _sharedOffset; }
+    void detach();
+    void startEditing();
+    int splitPieceAt(int pos);
+    void applyPendingEdits() const;
+
+    static int wordsForBits(int bitsCount) { return (bitsCount + kBitsInWord - 1) / kBitsInWord; }
+    static quint64 lowBitsMask(int length) { return length >= kBitsInWord ? ~Q_UINT64_C(0) : (Q_UINT64_C(1) << length) - 1; }
+};
+
+#endif // ITEMBITBUFFER_H
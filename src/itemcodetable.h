@@ -0,0 +1,115 @@
+#ifndef ITEMCODETABLE_H
+#define ITEMCODETABLE_H
+
+#include <QByteArray>
+#include <QVector>
+
+
+// Item codes ('amu', 'rin', 'xvhg', ...) are at most 4 bytes, so they're packed into an integer instead of being hashed.
+// 0 means no code: an empty string or one that doesn't fit.
+typedef quint32 ItemCode;
+
+inline ItemCode itemCodeFromType(const QByteArray &itemType)
+{
+    if (itemType.size() > 4)
+        return 0;
+
+    ItemCode code = 0;
+    for (int i = 0; i < itemType.size(); ++i)
+        code |= static_cast<ItemCode>(static_cast<quint8>(itemType.at(i))) << (i * 8);
+    return code;
+}
+
+inline QByteArray itemTypeFromCode(ItemCode code)
+{
+    QByteArray itemType;
+    for (; code; code >>= 8)
+        itemType += static_cast<char>(code & 0xFF);
+    return itemType;
+}
+
+// Open-addressing hash table with linear probing keyed by ItemCode, filled once and then only read.
+// Slots with key 0 are empty, the table is kept at most half full.
+template <typename T>
+class ItemCodeTable
+{
+public:
+    ItemCodeTable() : _size(0) {}
+
+    int size() const { return _size; }
+    bool isEmpty() const { return !_size; }
+
+    void clear()
+    {
+        _slots.clear();
+        _size = 0;
+    }
+
+    void reserve(int size)
+    {
+        int capacity = 16;
+        while (capacity < size * 2)
+            capacity *= 2;
+        if (capacity > _slots.size())
+            rehash(capacity);
+    }
+
+    void insert(ItemCode code, const T &value)
+    {
+        if (!code)
+            return;
+        if ((_size + 1) * 2 > _slots.size())
+            rehash(_slots.isEmpty() ? 16 : _slots.size() * 2);
+
+        Slot &slot = _slots[indexOf(code)];
+        if (!slot.code)
+        {
+            slot.code = code;
+            ++_size;
+        }
+        slot.value = value;
+    }
+
+    T value(ItemCode code) const
+    {
+        if (!code || _slots.isEmpty())
+            return T();
+        const Slot &slot = _slots.at(indexOf(code));
+        return slot.code ? slot.value : T();
+    }
+
+    bool contains(ItemCode code) const { return code && !_slots.isEmpty() && _slots.at(indexOf(code)).code; }
+
+private:
+    struct Slot
+    {
+        ItemCode code;
+        T value;
+
+        Slot() : code(0), value() {}
+    };
+
+    QVector<Slot> _slots;
+    int _size;
+
+    // the slot with the code or the empty one where it would be inserted
+    int indexOf(ItemCode code) const
+    {
+        int mask = _slots.size() - 1, i = (code * 2654435761u) >> 16 & mask; // multiplicative hashing spreads the ASCII bytes
+        while (_slots.at(i).code && _slots.at(i).code != code)
+            i = (i + 1) & mask;
+        return i;
+    }
+
+    void rehash(int capacity)
+    {
+        QVector<Slot> oldSlots = _slots;
+        _slots = QVector<Slot>(capacity);
+        _size = 0;
+        foreach (const Slot &slot, oldSlots)
+            if (slot.code)
+                insert(slot.code, slot.value);
+    }
+};
+
+#endif // ITEMCODETABLE_H
@@ -3,6 +3,7 @@
 #include "itemdatabase.h"
 #include "reversebitwriter.h"
 #include "resourcepathmanager.hpp"
+#include "itemsdb.h"
 #include <QVBoxLayout>
 #include <QGridLayout>
 #include <QMessageBox>
@@ -11,10 +12,8 @@
 #include <QComboBox>
 #include <QDir>
 #include <QTextStream>
+#include <QCoreApplication>
 #include <QLineEdit>
-#ifdef HAS_QTSQL
-#include <QtSql>
-#endif
 
 ItemCreationWidget::ItemCreationWidget(QWidget *parent)
     : QDialog(parent), _createdOrb(nullptr), _targetRow(0), _targetCol(0), _copies(1)
@@ -72,30 +71,13 @@ void ItemCreationWidget::setupUI()
 
     _previewLabel->setText(tr("Template: resources/items/47+.d2i"));
 
-    // First try to load orbs from a generated SQLite DB (resources/data/items.db)
-    bool loaded = false;
-#ifdef HAS_QTSQL
-    QString dbPath = QCoreApplication::applicationDirPath() + QStringLiteral("/../resources/data/items.db");
-    if (QFile::exists(dbPath)) {
-        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", "itemsdb_conn");
-        db.setDatabaseName(dbPath);
-        if (db.open()) {
-            QSqlQuery q(db);
-            if (q.exec("SELECT code, name FROM items WHERE name LIKE '%Mystic Orb%' OR name LIKE '%Mystic%' OR tags LIKE '%myst%';")) {
-                while (q.next()) {
-                    QString code = q.value(0).toString();
-                    QString name = q.value(1).toString();
-                    if (!code.isEmpty()) {
-                        _itemCombo->addItem(code + " - " + name, code);
-                    }
-                }
-                if (_itemCombo->count() > 0) loaded = true;
-            }
-            db.close();
-        }
-        QSqlDatabase::removeDatabase("itemsdb_conn");
+    // First try to load items from the generated SQLite DB (resources/data/items.db)
+    for (const ItemsDb::Item &item : ItemsDb::allItems()) {
+        QString display = item.code + " - " + item.name;
+        _itemCombo->addItem(display, item.code);
+        _allItems.append(display + "\t" + item.code);
     }
-#endif
+    bool loaded = _itemCombo->count() > 0;
 
     if (!loaded) {
         // TSV fallback: best-effort parse from generated items.tsv
@@ -127,11 +109,10 @@ void ItemCreationWidget::setupUI()
         // ensure some common items are present
         _itemCombo->addItem("scha - Small Charm of Alteration", "scha"); _allItems.append(QStringLiteral("scha - Small Charm of Alteration\tscha"));
         _itemCombo->addItem("chra - Small Charm of Finesse", "char"); _allItems.append(QStringLiteral("chra - Small Charm of Finesse\tchar"));
-
-        // connect filter
-        connect(_filterEdit, &QLineEdit::textChanged, this, &ItemCreationWidget::_onFilterTextChanged);
     }
 
+    // connect filter
+    connect(_filterEdit, &QLineEdit::textChanged, this, &ItemCreationWidget::_onFilterTextChanged);
 }
 
 void ItemCreationWidget::setItemPosition(int row, int column)
@@ -202,7 +183,7 @@ ItemInfo* ItemCreationWidget::createItemItem()
     item->move(_rowSpin->value(), _colSpin->value(), 0, true);
     item->storage = -1;
     item->hasChanged = true;
-    item->itemType = selectedCode.toUtf8();
+    item->setItemType(selectedCode.toUtf8());
     ReverseBitWriter::byteAlignBits(item->bitString);
     return item;
 }
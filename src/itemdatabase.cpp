@@ -5,71 +5,231 @@
 #include "itemparser.h"
 #include "characterinfo.hpp"
 #include "reversebitwriter.h"
-
-#include <QBuffer>
+#include "chunkeddatafile.h"
 
 #include <algorithm>
 
+#include <QMutex>
+#include <QThread>
+
+#if IS_QT5
+#include <QStandardPaths>
+#else
+#include <QDesktopServices>
+#endif
+
+#if IS_QT5
+#include <QtConcurrent/QtConcurrentMap>
+#else
+#include <QtConcurrentMap>
+#endif
+
 #ifndef QT_NO_DEBUG
 #include <QDebug>
 #endif
 
-#define TO_UINT16(byteArray) (static_cast<quint8>(byteArray.at(0)) + (static_cast<quint8>(byteArray.at(1)) << 8))
-#define CRC_OF_BYTEARRAY(byteArray) qChecksum(byteArray.constData(), byteArray.length())
-
 
 const double ItemDataBase::EtherealMultiplier = 1.25;
 const char *const ItemDataBase::kJewelType = "jew";
 QHash<QByteArray, FullSetInfo> ItemDataBase::_sets;
-QHash<QString, quint32> ItemDataBase::tblIndexLookup;
 
-QByteArray ItemDataBase::decompressedFileData(const QString &compressedFilePath, const QString &errorMessage)
+static QMutex loadErrorsMutex;
+static QStringList loadErrors;
+
+// dense copies of Items() and Properties() for the lookups done per item and per property, filled by the loaders
+static ItemCodeTable<ItemBase *> itemBasesByCode;
+static QVector<ItemPropertyTxt *> propertiesById;
+static QVector<quint8> propertyTraitsById;
+
+// filled by ItemTypes(): ids of type codes and, for every id, bits of all ids it inherits from
+static ItemCodeTable<int> itemTypeIds;
+static QVector<QBitArray> itemTypeClosures;
+
+// Every table is loaded once by the thread that asks for it first, other threads wait on the mutex until it's done.
+// A loaded table is never changed, so afterwards accessors only check the atomic flag.
+class TableGuard
 {
-    QFile f(compressedFilePath);
-    if (!f.open(QIODevice::ReadOnly))
+public:
+    class Locker
     {
-        ERROR_BOX_NO_PARENT(errorMessage + "\n" + tr("Reason: %1").arg(f.errorString()));
-        return QByteArray();
+    public:
+        explicit Locker(TableGuard *guard) : _guard(guard), _isLocked(!guard->isLoaded())
+        {
+            if (_isLocked)
+                _guard->_mutex.lock();
+        }
+        ~Locker()
+        {
+            if (_isLocked)
+                _guard->_mutex.unlock();
+        }
+
+        void setLoaded()
+        {
+            if (_isLocked)
+                _guard->_isLoaded.fetchAndStoreRelease(1);
+        }
+
+    private:
+        TableGuard *_guard;
+        bool _isLocked;
+    };
+
+    TableGuard() : _isLoaded(0) {}
+
+    bool isLoaded()
+    {
+#if IS_QT5
+        return _isLoaded.loadAcquire();
+#else
+        return _isLoaded.fetchAndAddAcquire(0);
+#endif
+    }
+
+private:
+    QAtomicInt _isLoaded;
+    QMutex _mutex;
+};
+
+enum Table
+{
+    StringTableTable,
+    ItemsTable,
+    PropertiesTable,
+    SetsTable,
+    UniquesTable,
+    SkillsTable,
+    ItemTypesTable,
+    RWTable,
+    SocketablesTable,
+    MonstersTable,
+    NonMagicItemQualitiesTable
+};
+
+static void loadTable(int table)
+{
+    switch (table)
+    {
+    case StringTableTable:
+        ItemDataBase::StringTable();
+        break;
+    case ItemsTable:
+        ItemDataBase::Items();
+        break;
+    case PropertiesTable:
+        ItemDataBase::Properties();
+        break;
+    case SetsTable:
+        ItemDataBase::Sets();
+        break;
+    case UniquesTable:
+        ItemDataBase::Uniques();
+        break;
+    case SkillsTable:
+        ItemDataBase::Skills();
+        break;
+    case ItemTypesTable:
+        ItemDataBase::ItemTypes();
+        break;
+    case RWTable:
+        ItemDataBase::RW();
+        break;
+    case SocketablesTable:
+        ItemDataBase::Socketables();
+        break;
+    case MonstersTable:
+        ItemDataBase::Monsters();
+        break;
+    case NonMagicItemQualitiesTable:
+        ItemDataBase::NonMagicItemQualities();
+        break;
+    default:
+        break;
+    }
+}
+
+QFuture<void> ItemDataBase::warmUp()
+{
+    // the biggest tables go first
+    static QList<int> tables = QList<int>() << StringTableTable << ItemsTable << PropertiesTable << SetsTable << UniquesTable << SkillsTable
+                                            << ItemTypesTable << RWTable << SocketablesTable << MonstersTable << NonMagicItemQualitiesTable;
+    return QtConcurrent::map(tables, loadTable);
+}
+
+QStringList ItemDataBase::takeLoadErrors()
+{
+    QMutexLocker locker(&loadErrorsMutex);
+    QStringList errors = loadErrors;
+    loadErrors.clear();
+    return errors;
+}
+
+void ItemDataBase::showLoadError(const QString &message)
+{
+    if (QThread::currentThread() == qApp->thread())
+        ERROR_BOX_NO_PARENT(message);
+    else
+    {
+        QMutexLocker locker(&loadErrorsMutex);
+        loadErrors += message;
     }
+}
+
+// one block of a chunked table file, blocks are decompressed and split into rows in parallel
+struct ChunkedTableBlock
+{
+    const ChunkedDataFile *file;
+    int index;
+    bool isBroken;
+    DataTableRows rows;
+};
+
+static void readChunkedTableBlock(ChunkedTableBlock &block)
+{
+    QByteArray text = block.file->blockText(block.index);
+    block.isBroken = text.isNull();
+    block.rows = DataSnapshot::rowsFromText(text, block.index == 0);
+}
 
-    QByteArray compressedCrcData = f.read(2), originalCrcData = f.read(2);
-    quint16 compressedCrc = TO_UINT16(compressedCrcData), originalCrc = TO_UINT16(originalCrcData);
-    static const QString decompressError(tr("Error decrypting file '%1'"));
-    QByteArray compressedDataFile = f.readAll();
-    if (CRC_OF_BYTEARRAY(compressedDataFile) != compressedCrc)
+QByteArray ItemDataBase::decompressedFileData(const QString &compressedFilePath, const QString &errorMessage)
+{
+    ChunkedDataFile chunkedFile;
+    if (chunkedFile.open(compressedFilePath))
     {
-        ERROR_BOX_NO_PARENT(decompressError.arg(compressedFilePath));
+        QList<int> brokenBlocks;
+        QByteArray text = chunkedFile.text(&brokenBlocks);
+        if (brokenBlocks.isEmpty())
+            return text;
+        showLoadError(tr("Error decrypting block %1 of file '%2'").arg(brokenBlocks.first()).arg(compressedFilePath));
         return QByteArray();
     }
 
-    QByteArray originalFileData = qUncompress(compressedDataFile);
-    if (CRC_OF_BYTEARRAY(originalFileData) != originalCrc)
+    QFile f(compressedFilePath);
+    if (!f.open(QIODevice::ReadOnly))
     {
-        ERROR_BOX_NO_PARENT(decompressError.arg(compressedFilePath));
+        showLoadError(errorMessage + "\n" + tr("Reason: %1").arg(f.errorString()));
         return QByteArray();
     }
 
+    QByteArray originalFileData = DataSnapshot::uncompressedData(f.readAll());
+    if (originalFileData.isNull())
+        showLoadError(tr("Error decrypting file '%1'").arg(compressedFilePath));
     return originalFileData;
 }
 
 QHash<QByteArray, ItemBase *> *ItemDataBase::Items()
 {
     static QHash<QByteArray, ItemBase *> allItems;
+    static TableGuard guard;
+    TableGuard::Locker locker(&guard);
     if (allItems.isEmpty())
     {
-        QByteArray fileData = decompressedFileData(ResourcePathManager::localizedPathForFileName("items"), tr("Items data not loaded."));
-        if (fileData.isEmpty())
+        DataTableRows rows = tableRows(ResourcePathManager::localizedFileName("items"), true, tr("Items data not loaded."));
+        if (rows.isEmpty())
             return 0;
 
-        QBuffer buf(&fileData);
-        if (!buf.open(QIODevice::ReadOnly))
-            return 0;
-        while (!buf.atEnd())
+        foreach (const DataTableRow &data, rows)
         {
-            QList<QByteArray> data = stringArrayOfCurrentLineInFile(buf);
-            if (data.isEmpty())
-                continue;
-
             ItemBase *item = new ItemBase;
             item->name = QString::fromUtf8(data.at(1));
             item->spelldesc = QString::fromUtf8(data.at(2)); // currently only misc items have it
@@ -97,56 +257,137 @@ QHash<QByteArray, ItemBase *> *ItemDataBase::Items()
             item->classCode = data.at(24).toShort();
             allItems[data.at(0)] = item;
         }
+
+        itemBasesByCode.reserve(allItems.size());
+        for (QHash<QByteArray, ItemBase *>::const_iterator iter = allItems.constBegin(); iter != allItems.constEnd(); ++iter)
+            itemBasesByCode.insert(itemCodeFromType(iter.key()), iter.value());
+
+        if (ItemTypes())
+        {
+            foreach (ItemBase *itemBase, allItems)
+            {
+                foreach (const QByteArray &type, itemBase->types)
+                    if (int typeId = itemTypeId(type))
+                        itemBase->typesClosure |= itemTypeClosures.at(typeId);
+            }
+        }
     }
+    locker.setLoaded();
     return &allItems;
 }
 
+ItemBase *ItemDataBase::itemBase(ItemCode code)
+{
+    return Items() ? itemBasesByCode.value(code) : 0;
+}
+
+static const QBitArray &itemTypeClosure(int typeId, const QList<QByteArray> &typeCodes, const QHash<QByteArray, ItemType> &types)
+{
+    QBitArray &closure = itemTypeClosures[typeId];
+    if (closure.isEmpty())
+    {
+        closure.resize(typeCodes.size() + 1);
+        closure.setBit(typeId); // before the recursion, so that a cycle in the data stops here
+        foreach (const QByteArray &baseType, types.value(typeCodes.at(typeId - 1)).baseItemTypes)
+            if (int baseTypeId = itemTypeIds.value(itemCodeFromType(baseType)))
+                closure |= itemTypeClosure(baseTypeId, typeCodes, types);
+    }
+    return closure;
+}
+
+int ItemDataBase::itemTypeId(const QByteArray &itemType)
+{
+    return ItemTypes() ? itemTypeIds.value(itemCodeFromType(itemType)) : 0;
+}
+
+bool ItemDataBase::itemTypeInheritsFrom(int typeId, int baseTypeId)
+{
+    return ItemTypes() && typeId > 0 && typeId < itemTypeClosures.size() && baseTypeId > 0 && baseTypeId < itemTypeClosures.size()
+        && itemTypeClosures.at(typeId).testBit(baseTypeId);
+}
+
 QHash<QByteArray, ItemType> *ItemDataBase::ItemTypes()
 {
     static QHash<QByteArray, ItemType> types;
+    static TableGuard guard;
+    TableGuard::Locker locker(&guard);
     if (types.isEmpty())
     {
-        QByteArray fileData = decompressedFileData(ResourcePathManager::dataPathForFileName("itemtypes.dat"), tr("Item types data not loaded."));
-        if (fileData.isEmpty())
+        DataTableRows rows = tableRows("itemtypes.dat", true, tr("Item types data not loaded."));
+        if (rows.isEmpty())
             return 0;
 
-        QBuffer buf(&fileData);
-        if (!buf.open(QIODevice::ReadOnly))
-            return 0;
-        while (!buf.atEnd())
+        foreach (const DataTableRow &data, rows)
         {
-            QList<QByteArray> data = stringArrayOfCurrentLineInFile(buf);
-            if (data.isEmpty())
-                continue;
-
             ItemType type;
             type.baseItemTypes = data.at(1).split(',');
             if (data.size() > 2)
                 type.variableImageNames = data.at(2).split(',');
             types[data.at(0)] = type;
         }
+
+        // base types missing from the first column get ids as well
+        QList<QByteArray> typeCodes;
+        for (QHash<QByteArray, ItemType>::const_iterator iter = types.constBegin(); iter != types.constEnd(); ++iter)
+        {
+            foreach (const QByteArray &typeCode, QList<QByteArray>() << iter.key() << iter.value().baseItemTypes)
+            {
+                ItemCode code = itemCodeFromType(typeCode);
+                if (code && !itemTypeIds.contains(code))
+                {
+                    typeCodes += typeCode;
+                    itemTypeIds.insert(code, typeCodes.size());
+                }
+            }
+        }
+        itemTypeClosures.fill(QBitArray(), typeCodes.size() + 1);
+        for (int typeId = 1; typeId <= typeCodes.size(); ++typeId)
+            itemTypeClosure(typeId, typeCodes, types);
     }
+    locker.setLoaded();
     return &types;
 }
 
+static quint8 propertyTraitsOf(uint id, const ItemPropertyTxt *prop)
+{
+    quint8 traits = 0;
+    if (id != Enums::ItemProperties::SkillCapIncrease && id != Enums::ItemProperties::CooldownReduction && prop->descPositive.startsWith('%'))
+        traits |= ItemDataBase::CtcTrait | ItemDataBase::SkillParamTrait;
+    if (ItemDataBase::MysticOrbs()->contains(id))
+        traits |= ItemDataBase::MysticOrbTrait;
+    if (!prop->groupIDs.isEmpty())
+        traits |= ItemDataBase::GroupTrait;
+
+    switch (id)
+    {
+    case Enums::ItemProperties::Oskill: case Enums::ItemProperties::ClassOnlySkill: case Enums::ItemProperties::ChargedSkill:
+        traits |= ItemDataBase::SkillParamTrait;
+        break;
+    case Enums::ItemProperties::MinimumDamageCold: case Enums::ItemProperties::MinimumDamagePoison:
+        traits |= ItemDataBase::DurationTrait;
+        // fall through
+    case Enums::ItemProperties::MinimumDamageFire: case Enums::ItemProperties::MinimumDamageLightning: case Enums::ItemProperties::MinimumDamageMagic:
+        traits |= ItemDataBase::ElementalMinDamageTrait;
+        break;
+    default:
+        break;
+    }
+    return traits;
+}
+
 QHash<uint, ItemPropertyTxt *> *ItemDataBase::Properties()
 {
     static QHash<uint, ItemPropertyTxt *> allProperties;
+    static TableGuard guard;
+    TableGuard::Locker locker(&guard);
     if (allProperties.isEmpty())
     {
-        QByteArray fileData = decompressedFileData(ResourcePathManager::localizedPathForFileName("props"), tr("Properties data not loaded."));
-        if (fileData.isEmpty())
+        DataTableRows rows = tableRows(ResourcePathManager::localizedFileName("props"), true, tr("Properties data not loaded."));
+        if (rows.isEmpty())
             return 0;
 
-        QBuffer buf(&fileData);
-        if (!buf.open(QIODevice::ReadOnly))
-            return 0;
-        while (!buf.atEnd())
+        foreach (const DataTableRow &data, rows)
         {
-            QList<QByteArray> data = stringArrayOfCurrentLineInFile(buf);
-            if (data.isEmpty())
-                continue;
-
             ItemPropertyTxt *prop = new ItemPropertyTxt;
             prop->add = data.at(1).toUShort();
             prop->bits = data.at(2).toUShort();
@@ -172,10 +413,32 @@ QHash<uint, ItemPropertyTxt *> *ItemDataBase::Properties()
             prop->stat = data.at(19);
             allProperties[data.at(0).toUInt()] = prop;
         }
+
+        uint maxId = 0;
+        foreach (uint id, allProperties.keys())
+            maxId = qMax(maxId, id);
+        propertiesById.fill(0, maxId + 1);
+        propertyTraitsById.fill(0, maxId + 1);
+        for (QHash<uint, ItemPropertyTxt *>::const_iterator iter = allProperties.constBegin(); iter != allProperties.constEnd(); ++iter)
+        {
+            propertiesById[iter.key()] = iter.value();
+            propertyTraitsById[iter.key()] = propertyTraitsOf(iter.key(), iter.value());
+        }
     }
+    locker.setLoaded();
     return &allProperties;
 }
 
+ItemPropertyTxt *ItemDataBase::propertyTxt(uint id)
+{
+    return Properties() && id < static_cast<uint>(propertiesById.size()) ? propertiesById.at(id) : 0;
+}
+
+uint ItemDataBase::propertyTraits(uint id)
+{
+    return Properties() && id < static_cast<uint>(propertyTraitsById.size()) ? propertyTraitsById.at(id) : 0;
+}
+
 QList<SetFixedProperty> collectSetProperties(const QList<QByteArray> &data, quint16 firstColumn, quint16 lastColumn = 0)
 {
     QList<SetFixedProperty> result;
@@ -199,22 +462,17 @@ QList<SetFixedProperty> collectSetProperties(const QList<QByteArray> &data, quin
 QHash<uint, SetItemInfo *> *ItemDataBase::Sets()
 {
     static QHash<uint, SetItemInfo *> allSets;
+    static TableGuard guard;
+    TableGuard::Locker locker(&guard);
     if (allSets.isEmpty())
     {
         // set items
-        QByteArray fileData = decompressedFileData(ResourcePathManager::localizedPathForFileName("setitems"), tr("Set items data not loaded."));
-        if (fileData.isEmpty())
+        DataTableRows rows = tableRows(ResourcePathManager::localizedFileName("setitems"), true, tr("Set items data not loaded."));
+        if (rows.isEmpty())
             return 0;
 
-        QBuffer buf(&fileData);
-        if (!buf.open(QIODevice::ReadOnly))
-            return 0;
-        while (!buf.atEnd())
+        foreach (const DataTableRow &data, rows)
         {
-            QList<QByteArray> data = stringArrayOfCurrentLineInFile(buf);
-            if (data.isEmpty())
-                continue;
-
             SetItemInfo *setItem = new SetItemInfo;
             setItem->itemName = QString::fromUtf8(data.at(1));
             setItem->setName  = QString::fromUtf8(data.at(2));
@@ -229,7 +487,6 @@ QHash<uint, SetItemInfo *> *ItemDataBase::Sets()
 
             _sets[setItem->key].itemNames << setItem->itemName;
         }
-        buf.close();
 
         // sort set item names
         for (QHash<QByteArray, FullSetInfo>::iterator it = _sets.begin(); it != _sets.end(); ++it)
@@ -239,16 +496,12 @@ QHash<uint, SetItemInfo *> *ItemDataBase::Sets()
         }
 
         // full set bonuses
-        fileData = decompressedFileData(ResourcePathManager::dataPathForFileName("sets.dat"), tr("Sets data not loaded."));
-        if (fileData.isEmpty())
+        rows = tableRows("sets.dat", true, tr("Sets data not loaded."));
+        if (rows.isEmpty())
             return 0;
 
-        buf.setBuffer(&fileData);
-        if (!buf.open(QIODevice::ReadOnly))
-            return 0;
-        while (!buf.atEnd())
+        foreach (const DataTableRow &data, rows)
         {
-            QList<QByteArray> data = stringArrayOfCurrentLineInFile(buf);
             if (data.size() < 2)
                 continue;
 
@@ -257,27 +510,23 @@ QHash<uint, SetItemInfo *> *ItemDataBase::Sets()
             info.fullSetProperties = collectSetProperties(data, 33);
         }
     }
+    locker.setLoaded();
     return &allSets;
 }
 
 QList<SkillInfo *> *ItemDataBase::Skills()
 {
     static QList<SkillInfo *> allSkills;
+    static TableGuard guard;
+    TableGuard::Locker locker(&guard);
     if (allSkills.isEmpty())
     {
-        QByteArray fileData = decompressedFileData(ResourcePathManager::localizedPathForFileName("skills"), tr("Skills data not loaded."));
-        if (fileData.isEmpty())
+        DataTableRows rows = tableRows(ResourcePathManager::localizedFileName("skills"), true, tr("Skills data not loaded."));
+        if (rows.isEmpty())
             return 0;
 
-        QBuffer buf(&fileData);
-        if (!buf.open(QIODevice::ReadOnly))
-            return 0;
-        while (!buf.atEnd())
+        foreach (const DataTableRow &data, rows)
         {
-            QList<QByteArray> data = stringArrayOfCurrentLineInFile(buf);
-            if (data.isEmpty())
-                continue;
-
             SkillInfo *skill = new SkillInfo;
             skill->name = QString::fromUtf8(data.at(1));
             skill->classCode = data.at(2).toShort();
@@ -291,27 +540,23 @@ QList<SkillInfo *> *ItemDataBase::Skills()
             allSkills.push_back(skill);
         }
     }
+    locker.setLoaded();
     return &allSkills;
 }
 
 QHash<uint, UniqueItemInfo *> *ItemDataBase::Uniques()
 {
     static QHash<uint, UniqueItemInfo *> allUniques;
+    static TableGuard guard;
+    TableGuard::Locker locker(&guard);
     if (allUniques.isEmpty())
     {
-        QByteArray fileData = decompressedFileData(ResourcePathManager::localizedPathForFileName("uniques"), tr("Uniques data not loaded."));
-        if (fileData.isEmpty())
+        DataTableRows rows = tableRows(ResourcePathManager::localizedFileName("uniques"), true, tr("Uniques data not loaded."));
+        if (rows.isEmpty())
             return 0;
 
-        QBuffer buf(&fileData);
-        if (!buf.open(QIODevice::ReadOnly))
-            return 0;
-        while (!buf.atEnd())
+        foreach (const DataTableRow &data, rows)
         {
-            QList<QByteArray> data = stringArrayOfCurrentLineInFile(buf);
-            if (data.isEmpty())
-                continue;
-
             UniqueItemInfo *uniqueItem = new UniqueItemInfo;
             uniqueItem->name = QString::fromUtf8(data.at(1));
             uniqueItem->rlvl = data.at(2).toUShort();
@@ -321,6 +566,7 @@ QHash<uint, UniqueItemInfo *> *ItemDataBase::Uniques()
             allUniques[data.at(0).toUInt()] = uniqueItem;
         }
     }
+    locker.setLoaded();
     return &allUniques;
 }
 
@@ -336,45 +582,36 @@ QHash<uint, MysticOrb *> *ItemDataBase::MysticOrbs()
 QHash<uint, QString> *ItemDataBase::Monsters()
 {
     static QHash<uint, QString> allMonsters;
+    static TableGuard guard;
+    TableGuard::Locker locker(&guard);
     if (allMonsters.isEmpty())
     {
-        QByteArray fileData = decompressedFileData(ResourcePathManager::localizedPathForFileName("monsters"), tr("Monster names not loaded."));
-        if (fileData.isEmpty())
+        DataTableRows rows = tableRows(ResourcePathManager::localizedFileName("monsters"), true, tr("Monster names not loaded."));
+        if (rows.isEmpty())
             return 0;
 
-        QBuffer buf(&fileData);
-        if (!buf.open(QIODevice::ReadOnly))
-            return 0;
-        while (!buf.atEnd())
+        foreach (const DataTableRow &data, rows)
         {
-            QList<QByteArray> data = stringArrayOfCurrentLineInFile(buf);
-            if (data.isEmpty())
-                continue;
-
             allMonsters[data.at(0).toUInt()] = data.size() > 1 ? QString::fromUtf8(data.at(1)) : QString();
         }
     }
+    locker.setLoaded();
     return &allMonsters;
 }
 
 RunewordHash *ItemDataBase::RW()
 {
     static RunewordHash allRunewords;
+    static TableGuard guard;
+    TableGuard::Locker locker(&guard);
     if (allRunewords.isEmpty())
     {
-        QByteArray fileData = decompressedFileData(ResourcePathManager::localizedPathForFileName("rw"), tr("Runewords data not loaded."));
-        if (fileData.isEmpty())
+        DataTableRows rows = tableRows(ResourcePathManager::localizedFileName("rw"), true, tr("Runewords data not loaded."));
+        if (rows.isEmpty())
             return 0;
 
-        QBuffer buf(&fileData);
-        if (!buf.open(QIODevice::ReadOnly))
-            return 0;
-        while (!buf.atEnd())
+        foreach (const DataTableRow &data, rows)
         {
-            QList<QByteArray> data = stringArrayOfCurrentLineInFile(buf);
-            if (data.isEmpty())
-                continue;
-
             RunewordInfo *rw = new RunewordInfo;
             int column = 0;
 
@@ -389,27 +626,23 @@ RunewordHash *ItemDataBase::RW()
             allRunewords.insert(key, rw);
         }
     }
+    locker.setLoaded();
     return &allRunewords;
 }
 
 QHash<QByteArray, SocketableItemInfo *> *ItemDataBase::Socketables()
 {
     static QHash<QByteArray, SocketableItemInfo *> allSocketables;
+    static TableGuard guard;
+    TableGuard::Locker locker(&guard);
     if (allSocketables.isEmpty())
     {
-        QByteArray fileData = decompressedFileData(ResourcePathManager::localizedPathForFileName("socketables"), tr("Socketables data not loaded."));
-        if (fileData.isEmpty())
+        DataTableRows rows = tableRows(ResourcePathManager::localizedFileName("socketables"), true, tr("Socketables data not loaded."));
+        if (rows.isEmpty())
             return 0;
 
-        QBuffer buf(&fileData);
-        if (!buf.open(QIODevice::ReadOnly))
-            return 0;
-        while (!buf.atEnd())
+        foreach (const DataTableRow &data, rows)
         {
-            QList<QByteArray> data = stringArrayOfCurrentLineInFile(buf);
-            if (data.isEmpty())
-                continue;
-
             SocketableItemInfo *item = new SocketableItemInfo;
             item->name = QString::fromUtf8(data.at(1));
             item->letter = QString::fromUtf8(data.at(2));
@@ -432,28 +665,25 @@ QHash<QByteArray, SocketableItemInfo *> *ItemDataBase::Socketables()
             allSocketables[data.at(0)] = item;
         }
     }
+    locker.setLoaded();
     return &allSocketables;
 }
 
 QStringList *ItemDataBase::NonMagicItemQualities()
 {
     static QStringList allQualities;
+    static TableGuard guard;
+    TableGuard::Locker locker(&guard);
     if (allQualities.isEmpty())
     {
-        QByteArray fileData = decompressedFileData(ResourcePathManager::localizedPathForFileName("LowQualityItems"), tr("Non-magic qualities data not loaded."));
-        if (fileData.isEmpty())
+        DataTableRows rows = tableRows(ResourcePathManager::localizedFileName("LowQualityItems"), true, tr("Non-magic qualities data not loaded."));
+        if (rows.isEmpty())
             return 0;
 
-        QBuffer buf(&fileData);
-        if (!buf.open(QIODevice::ReadOnly))
-            return 0;
-        while (!buf.atEnd())
-        {
-            QList<QByteArray> data = stringArrayOfCurrentLineInFile(buf);
-            if (!data.isEmpty())
-                allQualities << QString::fromUtf8(data.at(0));
-        }
+        foreach (const DataTableRow &data, rows)
+            allQualities << QString::fromUtf8(data.at(0));
     }
+    locker.setLoaded();
     return &allQualities;
 }
 
@@ -463,59 +693,124 @@ QString unquotedString(const QByteArray &ba)
     return s.size() > 2 ? s.mid(1, s.size() - 2) : QString();
 }
 
-QHash<quint32, QString> *ItemDataBase::StringTable()
+TblStringTable *ItemDataBase::StringTable()
 {
-    static QHash<quint32, QString> strings;
+    static TblStringTable strings;
+    static TableGuard guard;
+    TableGuard::Locker locker(&guard);
     if (strings.isEmpty())
     {
         quint32 i = 0;
         foreach (QLatin1String tblName, QList<QLatin1String>() << QLatin1String("string") << QLatin1String("patchstring") << QLatin1String("expansionstring"))
         {
-            QFile f(ResourcePathManager::localizedPathForFileName(tblName));
-            if (!f.open(QIODevice::ReadOnly))
-            {
-                ERROR_BOX_NO_PARENT(tr("String table '%1' not loaded.").arg(tblName) + "\n" + tr("Reason: %1").arg(f.errorString()));
-                return 0;
-            }
-
-            QByteArray fileData = f.readAll();
-            QBuffer buf(&fileData);
-            if (!buf.open(QIODevice::ReadOnly))
+            DataTableRows rows = tableRows(ResourcePathManager::localizedFileName(tblName), false, tr("String table '%1' not loaded.").arg(tblName));
+            if (rows.isEmpty())
                 return 0;
 
             quint32 j = i;
-            while (!buf.atEnd())
-            {
-                QList<QByteArray> data = stringArrayOfCurrentLineInFile(buf);
-                if (!data.isEmpty())
-                {
-                    strings[j] = data.size() > 1 ? unquotedString(data.at(1)) : QString();
-                    tblIndexLookup[unquotedString(data.at(0))] = j;
-                    ++j;
-                }
-            }
+            foreach (const DataTableRow &data, rows)
+                strings.append(j++, unquotedString(data.at(0)), data.size() > 1 ? unquotedString(data.at(1)) : QString());
 
             i += 10000;
         }
+        strings.buildHash();
     }
+    locker.setLoaded();
     return &strings;
 }
 
 QString ItemDataBase::stringFromTblKey(const QString &key)
 {
-    return key.isEmpty() ? QString() : StringTable()->value(tblIndexLookup.value(key));
+    return key.isEmpty() ? QString() : StringTable()->valueForKey(key);
 }
 
-QList<QByteArray> ItemDataBase::stringArrayOfCurrentLineInFile(QIODevice &d)
+DataSnapshot *ItemDataBase::dataSnapshot()
 {
-    bool isFirstPos = d.pos() == 0;
-    QByteArray itemString = d.readLine().trimmed();
-    return itemString.isEmpty() || (isFirstPos && itemString.startsWith('#')) ? QList<QByteArray>() : itemString.split('\t');
+    static DataSnapshot snapshot;
+    static bool isChecked = false;
+    static TableGuard guard;
+    TableGuard::Locker locker(&guard);
+    if (!isChecked)
+    {
+        // checked once per run: after a failed generation the tables are loaded from text until the next launch.
+        // A snapshot shipped with the resources (see utils/CreateDataSnapshot) is used as is, resources may be read-only,
+        // so a new one is written to the cache directory
+        isChecked = true;
+#if IS_QT5
+        QString cachePath = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+#else
+        QString cachePath = QDesktopServices::storageLocation(QDesktopServices::CacheLocation);
+#endif
+        QString locale = LanguageManager::instance().modLocalization(), dataPath = ResourcePathManager::dataPath(), snapshotPath = QString("%1/%2").arg(cachePath, DataSnapshot::fileName(locale));
+        if (!snapshot.open(ResourcePathManager::dataPathForFileName(DataSnapshot::fileName(locale))) || !snapshot.isUpToDate(dataPath, locale))
+        {
+            snapshot.close();
+            if (cachePath.isEmpty())
+                qWarning("no cache directory for the data snapshot, tables are loaded from text");
+            else if (!snapshot.open(snapshotPath) || !snapshot.isUpToDate(dataPath, locale))
+            {
+                // the snapshot must be unmapped before it's replaced
+                snapshot.close();
+                QString error;
+                if (DataSnapshot::generate(dataPath, locale, snapshotPath, &error))
+                    snapshot.open(snapshotPath);
+                else
+                    qWarning("data snapshot not created, tables are loaded from text: %s", qPrintable(error));
+            }
+        }
+    }
+    locker.setLoaded();
+    return snapshot.isOpen() ? &snapshot : 0;
+}
+
+DataTableRows ItemDataBase::tableRows(const QString &fileName, bool isCompressed, const QString &errorMessage)
+{
+    if (DataSnapshot *snapshot = dataSnapshot())
+    {
+        DataTableRows rows = snapshot->rows(fileName);
+        if (!rows.isEmpty())
+            return rows;
+    }
+
+    QString path = ResourcePathManager::dataPathForFileName(fileName);
+    if (isCompressed)
+    {
+        ChunkedDataFile chunkedFile;
+        if (!chunkedFile.open(path)) // legacy layout or the file can't be read
+            return DataSnapshot::rowsFromText(decompressedFileData(path, errorMessage));
+
+        QList<ChunkedTableBlock> blocks;
+        for (int i = 0; i < chunkedFile.blocksCount(); ++i)
+        {
+            ChunkedTableBlock block = { &chunkedFile, i, false, DataTableRows() };
+            blocks += block;
+        }
+        QtConcurrent::blockingMap(blocks, readChunkedTableBlock);
+
+        // rows of a broken block are lost, but the rest of the table is still usable
+        DataTableRows rows;
+        foreach (const ChunkedTableBlock &block, blocks)
+        {
+            if (block.isBroken)
+                showLoadError(tr("Error decrypting block %1 of file '%2'").arg(block.index).arg(path));
+            else
+                rows += block.rows;
+        }
+        return rows;
+    }
+
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly))
+    {
+        showLoadError(errorMessage + "\n" + tr("Reason: %1").arg(f.errorString()));
+        return DataTableRows();
+    }
+    return DataSnapshot::rowsFromText(f.readAll());
 }
 
 QString ItemDataBase::completeItemName(ItemInfo *item, bool shouldUseColor, bool showQualityText /*= true*/)
 {
-    QString itemName = Items()->value(item->itemType)->name, nonMagicalQuality;
+    QString itemName = itemBase(item->itemCode())->name, nonMagicalQuality;
     if (item->quality == Enums::ItemQuality::LowQuality)
         nonMagicalQuality = NonMagicItemQualities()->at(item->nonMagicType);
     else if (item->quality == Enums::ItemQuality::HighQuality)
@@ -545,7 +840,7 @@ QString ItemDataBase::completeItemName(ItemInfo *item, bool shouldUseColor, bool
     else if (item->quality == Enums::ItemQuality::Unique)
         specialName = Uniques()->contains(item->setOrUniqueId) ? Uniques()->value(item->setOrUniqueId)->name : QString();
     else if (item->isRW)
-        specialName = item->rwName;
+        specialName = item->rareInfo().rwName;
 
     if (isUberCharm(item))
     {
@@ -555,8 +850,9 @@ QString ItemDataBase::completeItemName(ItemInfo *item, bool shouldUseColor, bool
         specialName.clear();
     }
 
-    if (!item->inscribedName.isEmpty())
-        (specialName.isEmpty() || item->isRW ? itemName : specialName).prepend(tr("%1's ", "personalized name").arg(item->inscribedName.constData()));
+    QByteArray inscribedName = item->rareInfo().inscribedName;
+    if (!inscribedName.isEmpty())
+        (specialName.isEmpty() || item->isRW ? itemName : specialName).prepend(tr("%1's ", "personalized name").arg(inscribedName.constData()));
 
     if (shouldUseColor)
     {
@@ -615,7 +911,7 @@ QString ItemDataBase::completeItemName(ItemInfo *item, bool shouldUseColor, bool
             else if (item->isRW)
                 itemName.prepend(QString("[%1]%2").arg(tr("runeword"), kHtmlLineBreak));
 
-            QString spelldesc = Items()->value(item->itemType)->spelldesc;
+            QString spelldesc = itemBase(item->itemCode())->spelldesc;
             if (!spelldesc.isEmpty())
             {
                 expandMultilineString(&spelldesc);
@@ -766,14 +1062,14 @@ bool ItemDataBase::storeItemIn(ItemInfo *item, Enums::ItemStorage::ItemStorageEn
 bool ItemDataBase::canStoreItemAt(quint8 row, quint8 col, const QByteArray &storeItemType, const ItemsList &items, int rowsTotal, int colsTotal)
 {
     // col is horizontal (x), row is vertical (y)
-    ItemBase *storeItemBase = ItemDataBase::Items()->value(storeItemType);
+    ItemBase *storeItemBase = ItemDataBase::itemBase(storeItemType);
     QRect storeItemRect(col, row, storeItemBase->width, storeItemBase->height);
     if (storeItemRect.right() >= colsTotal || storeItemRect.bottom() >= rowsTotal) // beyond grid
         return false;
 
     foreach (ItemInfo *item, items)
     {
-        ItemBase *itemBase = ItemDataBase::Items()->value(item->itemType);
+        ItemBase *itemBase = ItemDataBase::itemBase(item->itemCode());
         if (storeItemRect.intersects(QRect(item->column, item->row, itemBase->width, itemBase->height)))
             return false;
     }
@@ -782,7 +1078,7 @@ bool ItemDataBase::canStoreItemAt(quint8 row, quint8 col, const QByteArray &stor
 
 bool ItemDataBase::isClassCharm(const QByteArray &itemType)
 {
-    foreach (const QByteArray &type, Items()->value(itemType)->types) //-V807
+    foreach (const QByteArray &type, itemBase(itemType)->types) //-V807
         if (type.startsWith("ara"))
             return true;
     return false;
@@ -805,7 +1101,7 @@ bool ItemDataBase::isUberCharm(const QByteArray &itemBaseType)
 
 bool ItemDataBase::isUberCharm(ItemInfo *item)
 {
-    return isUberCharm(Items()->value(item->itemType)->types);
+    return isUberCharm(itemBase(item->itemCode())->types);
 }
 
 bool ItemDataBase::isGenericSocketable(ItemInfo *item)
@@ -820,7 +1116,7 @@ bool ItemDataBase::isCube(ItemInfo *item)
 
 bool ItemDataBase::isTomeWithScrolls(ItemInfo *item)
 {
-    return ItemParser::itemTypesInheritFromType(Items()->value(item->itemType)->types, "book");
+    return ItemParser::itemTypesInheritFromType(itemBase(item->itemCode())->types, "book");
 }
 
 bool ItemDataBase::doesItemGrantBonus(ItemInfo *item)
@@ -832,14 +1128,14 @@ bool ItemDataBase::doesItemGrantBonus(ItemInfo *item)
 bool ItemDataBase::canDisenchantIntoArcaneShards(ItemInfo *item)
 {
     // prohibit disenchanting items with respective property and quest items into shards
-    return canDisenchant(item) && item->quality == Enums::ItemQuality::Unique && ItemParser::itemTypesInheritFromType(Items()->value(item->itemType)->types, "dcht")
-            && !(item->props.contains(Enums::ItemProperties::CantDisenchant) || Items()->value(item->itemType)->questId > 0);
+    return canDisenchant(item) && item->quality == Enums::ItemQuality::Unique && ItemParser::itemTypesInheritFromType(itemBase(item->itemCode())->types, "dcht")
+            && !(item->props.contains(Enums::ItemProperties::CantDisenchant) || itemBase(item->itemCode())->questId > 0);
 }
 
 bool ItemDataBase::canDisenchantIntoSignetOfLearning(ItemInfo *item)
 {
     // prohibit disenchanting TUs into signets
-    return canDisenchant(item) && (item->quality == Enums::ItemQuality::Set || item->quality == Enums::ItemQuality::Unique) && ItemParser::itemTypesInheritFromType(Items()->value(item->itemType)->types, "ssgl");
+    return canDisenchant(item) && (item->quality == Enums::ItemQuality::Set || item->quality == Enums::ItemQuality::Unique) && ItemParser::itemTypesInheritFromType(itemBase(item->itemCode())->types, "ssgl");
 }
 
 bool ItemDataBase::canDisenchant(ItemInfo *item)
@@ -2,8 +2,11 @@
 #define ITEMDATABASE_H
 
 #include "structs.h"
+#include "datasnapshot.h"
+#include "tblstringtable.h"
 #include "languagemanager.hpp"
 
+#include <QFuture>
 #include <QSet>
 
 
@@ -25,9 +28,33 @@ public:
     static const char *const kJewelType;
     static QByteArray decompressedFileData(const QString &compressedFilePath, const QString &errorMessage);
 
+    // Loads all tables in parallel on the global thread pool. Accessors below may be called from any thread at any time,
+    // a table that is still being loaded is waited for. Errors from the pool threads are kept for takeLoadErrors().
+    static QFuture<void> warmUp();
+    static QStringList takeLoadErrors();
+
     static QHash<QByteArray, ItemBase *> *Items();
+    static ItemBase *itemBase(ItemCode code);
+    static ItemBase *itemBase(const QByteArray &itemType) { return itemBase(itemCodeFromType(itemType)); }
     static QHash<QByteArray, ItemType> *ItemTypes();
+    // types from itemtypes.dat get ids starting from 1, inheritance between them is precomputed as a bitset per type
+    static int itemTypeId(const QByteArray &itemType); // 0 if unknown
+    static bool itemTypeInheritsFrom(int typeId, int baseTypeId); // a type inherits from itself
+    static bool itemBaseInheritsFrom(const ItemBase *itemBase, int baseTypeId) { return baseTypeId > 0 && baseTypeId < itemBase->typesClosure.size() && itemBase->typesClosure.testBit(baseTypeId); }
     static QHash<uint, ItemPropertyTxt *> *Properties();
+    static ItemPropertyTxt *propertyTxt(uint id); // same as Properties()->value(id), but indexes a flat array
+    // per-property checks done while parsing and displaying items, computed for every property when Properties() is loaded
+    enum PropertyTrait
+    {
+        CtcTrait = 1,
+        MysticOrbTrait = 2,
+        SkillParamTrait = 4, // param has a skill id: oskills, charges and ctc
+        ElementalMinDamageTrait = 8, // followed by max damage in the item bits
+        DurationTrait = 16, // elemental min damage followed by max damage and duration
+        GroupTrait = 32 // has descgroup ids
+    };
+    static uint propertyTraits(uint id); // 0 for unknown properties
+    static bool propertyHasTrait(uint id, PropertyTrait trait) { return (propertyTraits(id) & trait) != 0; }
     static QHash<uint, SetItemInfo *> *Sets();
     static QList<SkillInfo *> *Skills();
     static QHash<uint, UniqueItemInfo *> *Uniques();
@@ -37,8 +64,7 @@ public:
     static QHash<QByteArray, SocketableItemInfo *> *Socketables();
     static QStringList *NonMagicItemQualities();
 
-    static QHash<QString, quint32> tblIndexLookup;
-    static QHash<quint32, QString> *StringTable();
+    static TblStringTable *StringTable();
     static QString stringFromTblKey(const QString &key);
 
     static FullSetInfo fullSetInfoForKey(const QByteArray &setKey) { return _sets.value(setKey); }
@@ -65,7 +91,8 @@ public:
     static bool isTomeWithScrolls(ItemInfo *item);
 
     static bool doesItemGrantBonus(ItemInfo *item);
-    static bool isCtcProperty(int propId) { return propId != Enums::ItemProperties::SkillCapIncrease && propId != Enums::ItemProperties::CooldownReduction && Properties()->value(propId)->descPositive.startsWith('%'); }
+    static bool isCtcProperty(int propId) { return propertyHasTrait(propId, CtcTrait); }
+    static bool isMysticOrbProperty(int propId) { return propertyHasTrait(propId, MysticOrbTrait); }
 
     static bool canDisenchantIntoArcaneShards(ItemInfo *item);
     static bool canDisenchantIntoSignetOfLearning(ItemInfo *item);
@@ -73,7 +100,9 @@ public:
 private:
     static QHash<QByteArray, FullSetInfo> _sets;
 
-    static QList<QByteArray> stringArrayOfCurrentLineInFile(QIODevice &d);
+    static void showLoadError(const QString &message); // shows it right away only in the GUI thread
+    static DataSnapshot *dataSnapshot(); // 0 if it can't be opened or created
+    static DataTableRows tableRows(const QString &fileName, bool isCompressed, const QString &errorMessage); // fileName is relative to the data directory
     static void expandMultilineString(QString *stringToExpand);
 
     static bool canDisenchant(ItemInfo *item);
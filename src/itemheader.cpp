@@ -0,0 +1,39 @@
+#include "itemheader.h"
+#include "itemview.h"
+
+
+ItemHeader ItemHeader::fromItem(const ItemInfo *item)
+{
+    ItemHeader header;
+    header.guid = item->isExtended ? item->guid : 0;
+    header.plugyPage = item->plugyPage;
+    header.code = item->itemCode();
+    header.flags = (item->isQuest ? Quest : 0) | (item->isIdentified ? Identified : 0) | (item->isSocketed ? Socketed : 0) | (item->isEar ? Ear : 0)
+                 | (item->isStarter ? Starter : 0) | (item->isExtended ? Extended : 0) | (item->isEthereal ? Ethereal : 0)
+                 | (item->isPersonalized ? Personalized : 0) | (item->isRW ? RW : 0);
+    header.quality = item->isExtended ? item->quality : 0;
+    header.location = item->location;
+    header.storage = item->storage;
+    header.row = item->row;
+    header.column = item->column;
+    header.whereEquipped = item->whereEquipped;
+    return header;
+}
+
+ItemHeader ItemHeader::fromView(const ItemView &view)
+{
+    ItemHeader header;
+    header.guid = view.guid();
+    header.plugyPage = 0;
+    header.code = itemCodeFromType(view.itemType());
+    header.flags = (view.isQuest() ? Quest : 0) | (view.isIdentified() ? Identified : 0) | (view.isSocketed() ? Socketed : 0) | (view.isEar() ? Ear : 0)
+                 | (view.isStarter() ? Starter : 0) | (view.isExtended() ? Extended : 0) | (view.isEthereal() ? Ethereal : 0)
+                 | (view.isPersonalized() ? Personalized : 0) | (view.isRW() ? RW : 0);
+    header.quality = view.quality();
+    header.location = view.location();
+    header.storage = view.storage();
+    header.row = view.row();
+    header.column = view.column();
+    header.whereEquipped = view.whereEquipped();
+    return header;
+}
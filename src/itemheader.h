@@ -0,0 +1,46 @@
+#ifndef ITEMHEADER_H
+#define ITEMHEADER_H
+
+#include "structs.h"
+
+#include <QVector>
+
+
+class ItemView;
+
+// Fields of an item that the dupe scan compares, packed into 20 bytes with the item type as ItemCode instead of a QByteArray.
+// ItemHeaderTable keeps them in one contiguous array, so comparing thousands of items doesn't follow a pointer per item.
+// Headers are only snapshots for the scan: ItemInfo still owns these fields, a header is built from a loaded ItemInfo
+// or straight from the file bytes through ItemView.
+struct ItemHeader
+{
+    enum Flag
+    {
+        Quest = 1,
+        Identified = 2,
+        Socketed = 4,
+        Ear = 8,
+        Starter = 16,
+        Extended = 32,
+        Ethereal = 64,
+        Personalized = 128,
+        RW = 256
+    };
+
+    quint32 guid;      // 0 if the item isn't extended
+    quint32 plugyPage;
+    ItemCode code;
+    quint16 flags;
+    quint8 quality;    // 0 if the item isn't extended
+    qint8 location, storage, row, column, whereEquipped;
+
+    static ItemHeader fromItem(const ItemInfo *item);
+    static ItemHeader fromView(const ItemView &view);
+
+    bool hasFlag(Flag flag) const { return (flags & flag) != 0; }
+    bool isSameItemAs(const ItemHeader &other) const { return hasFlag(Extended) && guid == other.guid && code == other.code; } // what dupe scanner looks for
+};
+
+typedef QVector<ItemHeader> ItemHeaderTable;
+
+#endif // ITEMHEADER_H
@@ -8,9 +8,13 @@
 #include <QFile>
 #include <QDataStream>
 
+#include <cstring>
+
 #include <QDebug>
 
 
+bool ItemParser::_isLazyPropertiesDecoding = true;
+
 const QByteArray ItemParser::kItemHeader("JM");
 const QByteArray ItemParser::kPlugyPageHeader("STASH");
 
@@ -45,6 +49,99 @@ QString ItemParser::parseItemsToBuffer(quint16 itemsTotal, QDataStream &inputDat
 }
 
 ItemInfo *ItemParser::parseItem(QDataStream &inputDataStream, const QByteArray &bytes, bool isLastItemOnPlugyPage /*= false*/)
+{
+    return parseItem(inputDataStream, ItemsBuffer(bytes), isLastItemOnPlugyPage);
+}
+
+ItemInfo *ItemParser::parseItem(QDataStream &inputDataStream, const ItemsBuffer &buffer, bool isLastItemOnPlugyPage /*= false*/)
+{
+    int headerOffset = inputDataStream.device()->pos();
+    ItemInfo *item = parseItemByStructure(inputDataStream, buffer);
+    if (!item) // damaged item or unusual data after it
+        item = parseItemUpToNextHeader(inputDataStream, buffer.toByteArray(), isLastItemOnPlugyPage);
+    if (item && item->status == ItemInfo::Ok)
+    {
+        parseSocketables(item, inputDataStream, buffer, isLastItemOnPlugyPage);
+        item->fileOffset = headerOffset;
+        item->fileBytesCount = inputDataStream.device()->pos() - headerOffset;
+    }
+    return item;
+}
+
+ItemView ItemParser::parseItemView(const ItemsBuffer &buffer, int headerOffset)
+{
+    ItemInfo item; // only to walk the fields, properties are skipped
+    int itemEndOffset = parseItemStructure(&item, buffer.toByteArray(), headerOffset, true);
+    if (itemEndOffset == -1)
+        return ItemView();
+
+    int itemStartOffset = headerOffset + kItemHeader.size();
+    return ItemView(buffer, itemStartOffset, itemEndOffset - itemStartOffset);
+}
+
+bool ItemParser::parseItemViews(const ItemsBuffer &buffer, int *offset, int itemsTotal, QList<ItemView> *views)
+{
+    for (int i = 0; i < itemsTotal; ++i)
+    {
+        ItemView view = parseItemView(buffer, *offset);
+        if (view.isNull())
+            return false;
+
+        *views += view;
+        *offset = view.offset() + view.bytesCount();
+        if (!view.isEar() && view.isExtended() && !parseItemViews(buffer, offset, view.socketablesNumber(), views))
+            return false;
+    }
+    return true;
+}
+
+// the item's length comes from its own fields, so items are read back to back without searching for the next 'JM'.
+// Returns 0 if the item can't be parsed this way or doesn't end right before another item, a PlugY page or the end of data.
+ItemInfo *ItemParser::parseItemByStructure(QDataStream &inputDataStream, const ItemsBuffer &buffer)
+{
+    int headerOffset = inputDataStream.device()->pos();
+    ItemInfo *item = new ItemInfo;
+    int itemEndOffset = parseItemStructure(item, buffer.toByteArray(), headerOffset, _isLazyPropertiesDecoding);
+    if (itemEndOffset == -1)
+    {
+        delete item;
+        return 0;
+    }
+
+    int itemStartOffset = headerOffset + kItemHeader.size();
+    item->bitString = ItemBitBuffer::fromBuffer(buffer, itemStartOffset, itemEndOffset - itemStartOffset);
+    if (item->props.source())
+        item->props.source()->bits = item->bitString;
+    item->status = ItemInfo::Ok;
+    inputDataStream.device()->seek(itemEndOffset);
+    return item;
+}
+
+// returns offset of the byte after the item or -1 if it can't be parsed by its structure
+int ItemParser::parseItemStructure(ItemInfo *item, const QByteArray &bytes, int headerOffset, bool isLazyPropertiesDecoding)
+{
+    int itemStartOffset = headerOffset + kItemHeader.size();
+    if (!hasHeaderAt(bytes, headerOffset, kItemHeader))
+        return -1;
+
+    ReverseBitReader bitReader(bytes.constData() + itemStartOffset, bytes.size() - itemStartOffset, ReverseBitReader::StickyErrors);
+    ItemInfo::ParsingStatus status;
+    if (!parseItemFields(item, bitReader, &status, isLazyPropertiesDecoding))
+        return -1;
+
+    int itemEndOffset = itemStartOffset + (bitReader.pos() + 7) / 8; // items are byte aligned
+    if (itemEndOffset == bytes.size() || hasHeaderAt(bytes, itemEndOffset, kItemHeader) || hasHeaderAt(bytes, itemEndOffset, kPlugyPageHeader))
+        return itemEndOffset;
+    return -1;
+}
+
+bool ItemParser::hasHeaderAt(const QByteArray &bytes, int offset, const QByteArray &header)
+{
+    return offset >= 0 && offset + header.size() <= bytes.size() && !memcmp(bytes.constData() + offset, header.constData(), header.size());
+}
+
+// fallback for damaged files: the item ends at the next 'JM' (or PlugY page on the last page item)
+ItemInfo *ItemParser::parseItemUpToNextHeader(QDataStream &inputDataStream, const QByteArray &bytes, bool isLastItemOnPlugyPage)
 {
     ItemInfo *item = 0;
     ItemInfo::ParsingStatus status;
@@ -69,281 +166,409 @@ ItemInfo *ItemParser::parseItem(QDataStream &inputDataStream, const QByteArray &
         if (itemSize <= 0)
             break;
 
-        try
+        // the stream reads from the same bytes, so take the whole item at once and move past it
+        ItemBitBuffer itemBits = ItemBitBuffer::fromBytes(bytes.constData() + itemStartOffset, itemSize);
+        inputDataStream.skipRawData(itemSize);
+        ReverseBitReader bitReader(itemBits, ReverseBitReader::StickyErrors);
+
+        delete item;
+        item = new ItemInfo(itemBits);
+        if (!parseItemFields(item, bitReader, &status, _isLazyPropertiesDecoding))
         {
-            QString itemBitData;
-            itemBitData.reserve(itemSize * 8);
-            for (int i = 0; i < itemSize; ++i)
-            {
-                quint8 aByte;
-                inputDataStream >> aByte;
-                itemBitData.prepend(binaryStringFromNumber(aByte));
-            }
-            ReverseBitReader bitReader(itemBitData);
-
-            delete item;
-            item = new ItemInfo(bitReader.notReadBits());
-            item->isQuest = bitReader.readBool();
-            bitReader.skip(3);
-            item->isIdentified = bitReader.readBool();
-            bitReader.skip(5);
-            bitReader.skip(); // is duped
-            item->isSocketed = bitReader.readBool();
-            bitReader.skip(2);
-            bitReader.skip(2); // is illegal equip + unk
-            item->isEar = bitReader.readBool();
-            item->isStarter = bitReader.readBool();
-            bitReader.skip(2);
-            bitReader.skip();
-            item->isExtended = !bitReader.readBool();
-            item->isEthereal = bitReader.readBool();
-            bitReader.skip();
-            item->isPersonalized = bitReader.readBool();
-            bitReader.skip();
-            item->isRW = bitReader.readBool();
-            bitReader.skip(5);
-            bitReader.skip(8); // version - should be 101
-            bitReader.skip(2);
-            item->location = bitReader.readNumber(3);
-            item->whereEquipped = bitReader.readNumber(4);
-            item->column = bitReader.readNumber(4);
-            item->row = bitReader.readNumber(4);
-            if (item->location == Enums::ItemLocation::Belt)
-            {
-                item->row = item->column / kBeltMaxRows;
-                item->column %= kBeltMaxColumns;
-            }
-            item->storage = bitReader.readNumber(3);
+            qDebug("failed to parse item (%d - %d)", itemStartOffset, nextItemOffset);
+            inputDataStream.device()->seek(itemStartOffset - 2); // set to JM - beginning of the item //-V807
+            searchEndOffset = nextItemOffset + 1;
+            continue;
+        }
+    } while (status != ItemInfo::Ok && ++attempt < 2);
 
-            if (item->isEar)
-            {
-                item->earInfo.classCode = bitReader.readNumber(3);
-                item->earInfo.level = bitReader.readNumber(7);
-                for (int i = 0; i < 18; ++i)
-                {
-                    if (quint8 c = static_cast<quint8>(bitReader.readNumber(7)))
-                        item->earInfo.name += c;
-                    else
-                        break;
-                }
-                item->earInfo.name = item->earInfo.name.trimmed();
+    if (!item || (item->status = status) != ItemInfo::Ok)
+    {
+        qDebug("current offset %lld", inputDataStream.device()->pos());
+        inputDataStream.device()->seek(searchEndOffset - 1);
+        qDebug("new offset %lld", inputDataStream.device()->pos());
+    }
+    return item;
+}
+
+// stands in for the base of an item type missing from items.dat, items are parsed from several threads, so it's never changed after it's built
+static ItemBase createUnknownItemBase()
+{
+    ItemBase itemBase = ItemBase();
+    itemBase.name = "<unknown>";
+    itemBase.isStackable = false;
+    itemBase.genericType = Enums::ItemTypeGeneric::Misc;
+    return itemBase;
+}
 
-                item->itemType = "ear";
-                status = ItemInfo::Ok;
+static const ItemBase &unknownItemBase()
+{
+    static const ItemBase itemBase = createUnknownItemBase(); // initialization of a local static is thread-safe
+    return itemBase;
+}
+
+// decodes the item fields (socketables aren't parsed here), returns false if the item can't be parsed from these bits (status says why)
+bool ItemParser::parseItemFields(ItemInfo *item, ReverseBitReader &bitReader, ItemInfo::ParsingStatus *status, bool isLazyPropertiesDecoding)
+{
+    item->isQuest = bitReader.readBool();
+    bitReader.skip(3);
+    item->isIdentified = bitReader.readBool();
+    bitReader.skip(5);
+    bitReader.skip(); // is duped
+    item->isSocketed = bitReader.readBool();
+    bitReader.skip(2);
+    bitReader.skip(2); // is illegal equip + unk
+    item->isEar = bitReader.readBool();
+    item->isStarter = bitReader.readBool();
+    bitReader.skip(2);
+    bitReader.skip();
+    item->isExtended = !bitReader.readBool();
+    item->isEthereal = bitReader.readBool();
+    bitReader.skip();
+    item->isPersonalized = bitReader.readBool();
+    bitReader.skip();
+    item->isRW = bitReader.readBool();
+    bitReader.skip(5);
+    bitReader.skip(8); // version - should be 101
+    bitReader.skip(2);
+    item->location = bitReader.readNumber(3);
+    item->whereEquipped = bitReader.readNumber(4);
+    item->column = bitReader.readNumber(4);
+    item->row = bitReader.readNumber(4);
+    if (item->location == Enums::ItemLocation::Belt)
+    {
+        item->row = item->column / kBeltMaxRows;
+        item->column %= kBeltMaxColumns;
+    }
+    item->storage = bitReader.readNumber(3);
+
+    if (item->isEar)
+    {
+        ItemRareInfo &rareInfo = item->rareInfoForWrite();
+        rareInfo.earInfo.classCode = bitReader.readNumber(3);
+        rareInfo.earInfo.level = bitReader.readNumber(7);
+        for (int i = 0; i < 18; ++i)
+        {
+            if (quint8 c = static_cast<quint8>(bitReader.readNumber(7)))
+                rareInfo.earInfo.name += c;
+            else
                 break;
-            }
+        }
+        rareInfo.earInfo.name = rareInfo.earInfo.name.trimmed();
 
-            for (int i = 0; i < 4; ++i)
-                item->itemType += static_cast<quint8>(bitReader.readNumber(8));
-            item->itemType = item->itemType.trimmed();
+        if (bitReader.hasError())
+            return readFailed(bitReader.error(), status);
 
-            if (item->isExtended)
-            {
-                item->socketablesNumber = bitReader.readNumber(3);
-                item->guid = bitReader.readNumber(32);
-                item->ilvl = bitReader.readNumber(7);
-                item->quality = bitReader.readNumber(4);
-                if (bitReader.readBool())
-                    item->variableGraphicIndex = bitReader.readNumber(3) + 1;
-                // entry in the appropriate affix table (where a 0 value indicates none)
-                // is used for autoprefix and magic/rare/crafted/probably honorific items
-                if (bitReader.readBool()) // autoprefix
-                    bitReader.skip(11);
-
-                ItemBase *itemBase = ItemDataBase::Items()->value(item->itemType);
-                // Provide a safe fallback ItemBase to avoid dereferencing NULL later in parsing
-                static ItemBase _fallbackItemBase;
-                if (!itemBase) {
-                    qDebug() << "ItemParser: WARNING - ItemDataBase::Items() returned NULL for itemType:" << item->itemType;
-                    _fallbackItemBase.name = "<unknown>";
-                    _fallbackItemBase.types.clear();
-                    _fallbackItemBase.isStackable = false;
-                    _fallbackItemBase.genericType = Enums::ItemTypeGeneric::Misc;
-                    itemBase = &_fallbackItemBase;
-                }
-                switch (item->quality)
-                {
-                case Enums::ItemQuality::Normal:
-                    break;
-                case Enums::ItemQuality::LowQuality: case Enums::ItemQuality::HighQuality:
-                    item->nonMagicType = bitReader.readNumber(3);
-                    break;
-                case Enums::ItemQuality::Magic:
-                    bitReader.skip(22); // prefix & suffix
-                    break;
-                case Enums::ItemQuality::Set: case Enums::ItemQuality::Unique:
-                    item->setOrUniqueId = bitReader.readNumber(15);
-                    break;
-                case Enums::ItemQuality::Rare: case Enums::ItemQuality::Crafted:
-                    bitReader.skip(16); // first & second names
-                    for (int i = 0; i < 6; ++i)
-                        if (bitReader.readBool())
-                            bitReader.skip(11); // prefix or suffix (1-3)
-                    break;
-                case Enums::ItemQuality::Honorific:
-                    bitReader.skip(16); // no idea what these bits mean
-                    break;
-                default: {
-                    QString baseName = itemBase ? itemBase->name : QString("<unknown>");
-                    qDebug("Item '%s' of unknown quality %d found!", baseName.toUtf8().constData(), item->quality);
-                    break;
-                }
-                }
+        item->setItemType("ear");
+        *status = ItemInfo::Ok;
+        return true;
+    }
 
-                if (item->isRW)
-                    bitReader.skip(16); // RW code - don't know how to use it
+    QByteArray itemType;
+    for (int i = 0; i < 4; ++i)
+        itemType += static_cast<quint8>(bitReader.readNumber(8));
+    item->setItemType(itemType.trimmed());
 
-                item->inscribedNameOffset = bitReader.pos();
-                if (item->isPersonalized)
-                {
-                    for (int i = 0; i < 16; ++i)
-                    {
-                        quint8 c = static_cast<quint8>(bitReader.readNumber(kInscribedNameCharacterLength));
-                        if (!c)
-                            break;
-                        item->inscribedName += c;
-                    }
-                }
+    if (item->isExtended)
+    {
+        item->socketablesNumber = bitReader.readNumber(3);
+        item->guid = bitReader.readNumber(32);
+        item->ilvl = bitReader.readNumber(7);
+        item->quality = bitReader.readNumber(4);
+        if (bitReader.readBool())
+            item->variableGraphicIndex = bitReader.readNumber(3) + 1;
+        // entry in the appropriate affix table (where a 0 value indicates none)
+        // is used for autoprefix and magic/rare/crafted/probably honorific items
+        if (bitReader.readBool()) // autoprefix
+            bitReader.skip(11);
+
+        const ItemBase *itemBase = ItemDataBase::itemBase(item->itemCode());
+        if (!itemBase)
+        {
+            qDebug() << "ItemParser: WARNING - ItemDataBase::Items() returned NULL for itemType:" << item->itemType;
+            itemBase = &unknownItemBase();
+        }
+        switch (item->quality)
+        {
+        case Enums::ItemQuality::Normal:
+            break;
+        case Enums::ItemQuality::LowQuality: case Enums::ItemQuality::HighQuality:
+            item->nonMagicType = bitReader.readNumber(3);
+            break;
+        case Enums::ItemQuality::Magic:
+            bitReader.skip(22); // prefix & suffix
+            break;
+        case Enums::ItemQuality::Set: case Enums::ItemQuality::Unique:
+            item->setOrUniqueId = bitReader.readNumber(15);
+            break;
+        case Enums::ItemQuality::Rare: case Enums::ItemQuality::Crafted:
+            bitReader.skip(16); // first & second names
+            for (int i = 0; i < 6; ++i)
+                if (bitReader.readBool())
+                    bitReader.skip(11); // prefix or suffix (1-3)
+            break;
+        case Enums::ItemQuality::Honorific:
+            bitReader.skip(16); // no idea what these bits mean
+            break;
+        default: {
+            QString baseName = itemBase ? itemBase->name : QString("<unknown>");
+            qDebug("Item '%s' of unknown quality %d found!", baseName.toUtf8().constData(), item->quality);
+            break;
+        }
+        }
 
-                bitReader.skip(); // tome of ID bit
-                if (ItemDataBase::isTomeWithScrolls(item))
-                    bitReader.skip(5); // book ID
+        if (item->isRW)
+            bitReader.skip(16); // RW code - don't know how to use it
 
-                const bool isArmor = itemTypesInheritFromType(itemBase->types, "armo");
-                if (isArmor)
-                {
-                    ItemPropertyTxt *defenceProp = ItemDataBase::Properties()->value(Enums::ItemProperties::Defence);
-                    item->defense = bitReader.readNumber(defenceProp->bits) - defenceProp->add;
-                }
-                if (isArmor || itemTypesInheritFromType(itemBase->types, "weap"))
-                {
-                    ItemPropertyTxt *maxDurabilityProp = ItemDataBase::Properties()->value(Enums::ItemProperties::DurabilityMax);
-                    item->maxDurability = bitReader.readNumber(maxDurabilityProp->bits) - maxDurabilityProp->add;
-                    if (item->maxDurability)
-                    {
-                        ItemPropertyTxt *durabilityProp = ItemDataBase::Properties()->value(Enums::ItemProperties::Durability);
-                        item->currentDurability = bitReader.readNumber(durabilityProp->bits) - durabilityProp->add;
-                        if (item->maxDurability < item->currentDurability)
-                            item->maxDurability = item->currentDurability;
-                    }
-                }
+        item->inscribedNameOffset = bitReader.pos();
+        if (item->isPersonalized)
+        {
+            QByteArray &inscribedName = item->rareInfoForWrite().inscribedName;
+            for (int i = 0; i < 16; ++i)
+            {
+                quint8 c = static_cast<quint8>(bitReader.readNumber(kInscribedNameCharacterLength));
+                if (!c)
+                    break;
+                inscribedName += c;
+            }
+        }
 
-                item->quantity = itemBase->isStackable ? bitReader.readNumber(9) : -1;
-                if (item->isSocketed)
-                    item->socketsNumber = bitReader.readNumber(4);
+        bitReader.skip(); // tome of ID bit
+        if (ItemDataBase::isTomeWithScrolls(item))
+            bitReader.skip(5); // book ID
 
-                const int kSetListsNumber = 5;
-                bool hasSetLists[kSetListsNumber] = {false};
-                if (item->quality == Enums::ItemQuality::Set)
-                    for (int i = 0; i < kSetListsNumber; ++i)
-                        hasSetLists[i] = bitReader.readBool();
+        static const int kArmorTypeId = ItemDataBase::itemTypeId("armo"), kWeaponTypeId = ItemDataBase::itemTypeId("weap");
+        const bool isArmor = ItemDataBase::itemBaseInheritsFrom(itemBase, kArmorTypeId);
+        if (isArmor)
+        {
+            ItemPropertyTxt *defenceProp = ItemDataBase::propertyTxt(Enums::ItemProperties::Defence);
+            item->defense = bitReader.readNumber(defenceProp->bits) - defenceProp->add;
+        }
+        if (isArmor || ItemDataBase::itemBaseInheritsFrom(itemBase, kWeaponTypeId))
+        {
+            ItemPropertyTxt *maxDurabilityProp = ItemDataBase::propertyTxt(Enums::ItemProperties::DurabilityMax);
+            item->maxDurability = bitReader.readNumber(maxDurabilityProp->bits) - maxDurabilityProp->add;
+            if (item->maxDurability)
+            {
+                ItemPropertyTxt *durabilityProp = ItemDataBase::propertyTxt(Enums::ItemProperties::Durability);
+                item->currentDurability = bitReader.readNumber(durabilityProp->bits) - durabilityProp->add;
+                if (item->maxDurability < item->currentDurability)
+                    item->maxDurability = item->currentDurability;
+            }
+        }
 
-                item->props = parseItemProperties(bitReader, &status);
-                if (status != ItemInfo::Ok)
-                {
-                    inputDataStream.device()->seek(itemStartOffset - 2); // set to JM - beginning of the item
-                    item->props.insert(0, new ItemProperty(tr("Error parsing item properties (status == failed), please report!")));
-                    searchEndOffset = nextItemOffset + 1;
-                    continue;
-                }
+        item->quantity = itemBase->isStackable ? bitReader.readNumber(9) : -1;
+        if (item->isSocketed)
+            item->socketsNumber = bitReader.readNumber(4);
 
-                PropertiesMultiMap::iterator blessPropIter = item->props.find(Enums::ItemProperties::ShrineBless); // impossible to put inside the condition
-                if (blessPropIter != item->props.end())
-                {
-                    QString newDesc = ItemDataBase::isUberCharm(item) ? (ItemDataBase::isClassCharm(item) ? tr("Veterans") : tr("Trophy'd"))
-                                                                      : tr("Blessed");
-                    blessPropIter.value()->displayString = QString("[%1]").arg(newDesc);
-                }
-                if (ItemDataBase::isUberCharm(item))
-                {
-                    PropertiesMultiMap::iterator trophyPropIter = item->props.find(Enums::ItemProperties::Trophy);
-                    if (trophyPropIter != item->props.end())
-                        trophyPropIter.value()->displayString = QString("[%1]").arg(tr("Trophy'd"));
-
-                    QList<int> upgradeProps = QList<int>() << Enums::ItemProperties::EdyremUpgrade;
-                    for (int cubeUpgradeStat = Enums::ItemProperties::CubeUpgrade1; cubeUpgradeStat <= Enums::ItemProperties::CubeUpgrade4; ++cubeUpgradeStat)
-                        upgradeProps << cubeUpgradeStat;
-                    foreach (int upgradeProp, upgradeProps)
-                    {
-                        PropertiesMultiMap::iterator upgradePropIter = item->props.find(upgradeProp);
-                        if (upgradePropIter != item->props.end())
-                            upgradePropIter.value()->displayString = QString("[%1]").arg(ItemDataBase::isClassCharm(item) ? tr("Veterans") : tr("Upgraded"));
-                    }
-                }
+        const int kSetListsNumber = 5;
+        bool hasSetLists[kSetListsNumber] = {false};
+        if (item->quality == Enums::ItemQuality::Set)
+            for (int i = 0; i < kSetListsNumber; ++i)
+                hasSetLists[i] = bitReader.readBool();
 
-                if (item->quality == Enums::ItemQuality::Set)
-                    for (int i = 0; i < kSetListsNumber; ++i)
-                        if (hasSetLists[i])
-                            /*item->setProps = */parseItemProperties(bitReader, &status);
+        // property lists handle read errors themselves
+        if (bitReader.hasError())
+            return readFailed(bitReader.error(), status);
 
-                if (item->isRW)
-                {
-                    item->rwProps = parseItemProperties(bitReader, &status);
-                    if (status != ItemInfo::Ok)
-                    {
-                        inputDataStream.device()->seek(itemStartOffset - 2); // set to JM - beginning of the item
-                        item->rwProps.insert(1, new ItemProperty(tr("Error parsing RW properties (status == failed), please report!")));
-                        searchEndOffset = nextItemOffset + 1;
-                        continue;
-                    }
-                }
+        int setListsNumber = 0;
+        for (int i = 0; i < kSetListsNumber; ++i)
+            setListsNumber += hasSetLists[i];
+        if (isLazyPropertiesDecoding)
+        {
+            // only check that the lists are fine and find where they end, ItemProperty objects are created on first access
+            ReverseBitReader listsReader(bitReader);
+            if (skipPropertyLists(listsReader, setListsNumber, item->isRW))
+            {
+                QSharedPointer<LazyPropertyLists> lists(new LazyPropertyLists);
+                lists->bits = item->bitString; // parseItemByStructure() sets it later
+                lists->offset = bitReader.pos();
+                lists->itemType = item->itemType;
+                lists->setListsNumber = setListsNumber;
+                lists->isRW = item->isRW;
+                item->props.setSource(lists, LazyPropertiesMultiMap::ItemList);
+                item->rwProps.setSource(lists, LazyPropertiesMultiMap::RunewordList);
+                bitReader = listsReader;
+            }
+        }
 
-                // parse all socketables
-                QByteArray rwKey;
-                for (int i = 0; i < item->socketablesNumber; ++i)
-                {
-                    ItemInfo *socketableInfo = parseItem(inputDataStream, bytes, isLastItemOnPlugyPage);
-                    item->socketablesInfo += socketableInfo;
-                    if (item->isRW && socketableInfo->itemType != ItemDataBase::kJewelType)
-                        rwKey += socketableInfo->itemType;
-                }
+        if (!item->props.source()) // damaged lists are decoded right away to show what's wrong
+        {
+            item->props = parseItemProperties(bitReader, status);
+            if (*status != ItemInfo::Ok)
+            {
+                item->props.insert(0, new ItemProperty(tr("Error parsing item properties (status == failed), please report!")));
+                return false;
+            }
+            setCharmPropertiesDisplayStrings(item->props, item->itemType);
+
+            for (int i = 0; i < setListsNumber; ++i)
+                /*item->setProps = */parseItemProperties(bitReader, status);
 
-                if (!rwKey.isEmpty())
+            if (item->isRW)
+            {
+                item->rwProps = parseItemProperties(bitReader, status);
+                if (*status != ItemInfo::Ok)
                 {
-                    const RunewordHash *const rwHash = ItemDataBase::RW();
-                    RunewordHash::const_iterator iter = rwHash->find(rwKey);
-                    for (; iter != rwHash->end() && iter.key() == rwKey; ++iter)
-                    {
-                        RunewordInfo *rwInfo = iter.value();
-                        if (itemTypesInheritFromTypes(itemBase->types, rwInfo->allowedItemTypes))
-                        {
-                            item->rwName = rwInfo->name;
-                            break;
-                        }
-                    }
-                    if (iter == rwHash->end())
-                        item->rwName = tr("Unknown RW, please report!");
+                    item->rwProps.insert(1, new ItemProperty(tr("Error parsing RW properties (status == failed), please report!")));
+                    return false;
                 }
-                else if (item->isRW) // jewelword
-                    item->rwName = ItemDataBase::RW()->value(ItemDataBase::kJewelType)->name;
             }
-            else
-                item->quality = Enums::ItemQuality::Normal;
+        }
+    }
+    else
+    {
+        item->quality = Enums::ItemQuality::Normal;
+        if (bitReader.hasError())
+            return readFailed(bitReader.error(), status);
+    }
+
+    if (item->whereEquipped > 12)
+        return readFailed(4, status);
+    else if (item->storage > Enums::ItemStorage::Stash)
+        return readFailed(5, status);
+
+    *status = ItemInfo::Ok;
+    return true;
+}
+
+void ItemParser::parseSocketables(ItemInfo *item, QDataStream &inputDataStream, const ItemsBuffer &buffer, bool isLastItemOnPlugyPage)
+{
+    if (item->isEar || !item->isExtended)
+        return;
 
-            if (item->whereEquipped > 12)
-                throw 4;
-            else if (item->storage > Enums::ItemStorage::Stash)
-                throw 5;
+    QByteArray rwKey;
+    for (int i = 0; i < item->socketablesNumber; ++i)
+    {
+        ItemInfo *socketableInfo = parseItem(inputDataStream, buffer, isLastItemOnPlugyPage);
+        item->socketablesInfo += socketableInfo;
+        if (item->isRW && socketableInfo->itemType != ItemDataBase::kJewelType)
+            rwKey += socketableInfo->itemType;
+    }
 
-            status = ItemInfo::Ok;
+    if (!rwKey.isEmpty())
+    {
+        ItemBase *itemBase = ItemDataBase::itemBase(item->itemCode());
+        const RunewordHash *const rwHash = ItemDataBase::RW();
+        RunewordHash::const_iterator iter = rwHash->find(rwKey);
+        for (; iter != rwHash->end() && iter.key() == rwKey; ++iter)
+        {
+            RunewordInfo *rwInfo = iter.value();
+            if (itemBase && itemTypesInheritFromTypes(itemBase->types, rwInfo->allowedItemTypes))
+            {
+                item->rareInfoForWrite().rwName = rwInfo->name;
+                break;
+            }
         }
-        catch (int exceptionCode)
+        if (iter == rwHash->end())
+            item->rareInfoForWrite().rwName = tr("Unknown RW, please report!");
+    }
+    else if (item->isRW) // jewelword
+        item->rareInfoForWrite().rwName = ItemDataBase::RW()->value(ItemDataBase::kJewelType)->name;
+}
+
+void ItemParser::setCharmPropertiesDisplayStrings(PropertiesMultiMap &props, const QByteArray &itemType)
+{
+    ItemBase *itemBase = ItemDataBase::itemBase(itemType);
+    bool isUberCharm = itemBase && ItemDataBase::isUberCharm(itemBase->types);
+    PropertiesMultiMap::iterator blessPropIter = props.find(Enums::ItemProperties::ShrineBless); // impossible to put inside the condition
+    if (blessPropIter != props.end())
+    {
+        QString newDesc = isUberCharm ? (ItemDataBase::isClassCharm(itemType) ? tr("Veterans") : tr("Trophy'd"))
+                                      : tr("Blessed");
+        blessPropIter.value()->displayString = QString("[%1]").arg(newDesc);
+    }
+    if (isUberCharm)
+    {
+        PropertiesMultiMap::iterator trophyPropIter = props.find(Enums::ItemProperties::Trophy);
+        if (trophyPropIter != props.end())
+            trophyPropIter.value()->displayString = QString("[%1]").arg(tr("Trophy'd"));
+
+        QList<int> upgradeProps = QList<int>() << Enums::ItemProperties::EdyremUpgrade;
+        for (int cubeUpgradeStat = Enums::ItemProperties::CubeUpgrade1; cubeUpgradeStat <= Enums::ItemProperties::CubeUpgrade4; ++cubeUpgradeStat)
+            upgradeProps << cubeUpgradeStat;
+        foreach (int upgradeProp, upgradeProps)
         {
-            qDebug("caught exception %d while parsing item (%d - %d)", exceptionCode, itemStartOffset, nextItemOffset);
-            status = ItemInfo::Corrupted;
-            inputDataStream.device()->seek(itemStartOffset - 2); // set to JM - beginning of the item //-V807
-            searchEndOffset = nextItemOffset + 1;
-            continue;
+            PropertiesMultiMap::iterator upgradePropIter = props.find(upgradeProp);
+            if (upgradePropIter != props.end())
+                upgradePropIter.value()->displayString = QString("[%1]").arg(ItemDataBase::isClassCharm(itemType) ? tr("Veterans") : tr("Upgraded"));
         }
-    } while (status != ItemInfo::Ok && ++attempt < 2);
+    }
+}
 
-    if (!item || (item->status = status) != ItemInfo::Ok)
+bool ItemParser::skipItemProperties(ReverseBitReader &bitReader)
+{
+    using namespace Enums;
+
+    // reads the same bits as parseItemProperties()
+    while (bitReader.pos() != -1)
     {
-        qDebug("current offset %lld", inputDataStream.device()->pos());
-        inputDataStream.device()->seek(searchEndOffset - 1);
-        qDebug("new offset %lld", inputDataStream.device()->pos());
+        int id = bitReader.readNumber(CharacterStats::StatCodeLength);
+        if (bitReader.hasError())
+            return false;
+        if (id == ItemProperties::End)
+            return true;
+
+        ItemPropertyTxt *txtProperty = ItemDataBase::propertyTxt(id);
+        if (!txtProperty)
+            return false;
+        if (txtProperty->paramBits)
+            bitReader.readNumber(txtProperty->paramBits);
+        bitReader.readNumber(txtProperty->bits);
+        if (id == ItemProperties::EnhancedDamage)
+            bitReader.readNumber(txtProperty->bits);
+
+        uint traits = ItemDataBase::propertyTraits(id);
+        if (traits & ItemDataBase::ElementalMinDamageTrait)
+        {
+            bitReader.readNumber(ItemDataBase::propertyTxt(id + 1)->bits);
+            if (traits & ItemDataBase::DurationTrait)
+                bitReader.readNumber(ItemDataBase::propertyTxt(id + 2)->bits);
+        }
+
+        if (bitReader.hasError())
+            return false;
     }
-    return item;
+    return false;
+}
+
+bool ItemParser::skipPropertyLists(ReverseBitReader &bitReader, int setListsNumber, bool isRW)
+{
+    if (!skipItemProperties(bitReader))
+        return false;
+    for (int i = 0; i < setListsNumber; ++i)
+        if (!skipItemProperties(bitReader))
+            return false;
+    return !isRW || skipItemProperties(bitReader);
+}
+
+void ItemParser::decodePropertyLists(LazyPropertyLists *lists)
+{
+    ReverseBitReader bitReader(lists->bits, ReverseBitReader::StickyErrors);
+    bitReader.setPos(lists->offset);
+
+    ItemInfo::ParsingStatus status;
+    lists->props = parseItemProperties(bitReader, &status);
+    setCharmPropertiesDisplayStrings(lists->props, lists->itemType);
+    for (int i = 0; i < lists->setListsNumber; ++i)
+        skipItemProperties(bitReader);
+    if (lists->isRW)
+        lists->rwProps = parseItemProperties(bitReader, &status);
+
+    lists->isDecoded = true;
+    lists->bits.clear();
+}
+
+void LazyPropertyLists::decode()
+{
+    ItemParser::decodePropertyLists(this);
+}
+
+bool ItemParser::readFailed(int errorCode, ItemInfo::ParsingStatus *status)
+{
+    qDebug("error %d while parsing item", errorCode);
+    *status = ItemInfo::Corrupted;
+    return false;
 }
 
 PropertiesMultiMap ItemParser::parseItemProperties(ReverseBitReader &bitReader, ItemInfo::ParsingStatus *status)
@@ -353,105 +578,109 @@ PropertiesMultiMap ItemParser::parseItemProperties(ReverseBitReader &bitReader,
     PropertiesMultiMap props;
     while (bitReader.pos() != -1)
     {
-        ItemProperty *propToAdd = 0;
-        try
+        int id = bitReader.readNumber(CharacterStats::StatCodeLength);
+        if (bitReader.hasError())
+            return corruptedProperties(props, bitReader.error(), status);
+        if (id == ItemProperties::End)
         {
-            int id = bitReader.readNumber(CharacterStats::StatCodeLength);
-            if (id == ItemProperties::End)
-            {
 #ifndef QT_NO_DEBUG
-                qDebug() << QString("ItemParser: Finished parsing %1 properties")
-                           .arg(props.size());
+            qDebug() << QString("ItemParser: Finished parsing %1 properties")
+                       .arg(props.size());
 #endif
-                *status = ItemInfo::Ok;
-                return props;
-            }
+            *status = ItemInfo::Ok;
+            return props;
+        }
 
-            propToAdd = new ItemProperty;
-            propToAdd->bitStringOffset = bitReader.pos() + 16; // include 'JM' bit length
-
-            ItemPropertyTxt *txtProperty = ItemDataBase::Properties()->value(id);
-            if (!txtProperty)
-                throw 6;
-            propToAdd->param = txtProperty->paramBits ? bitReader.readNumber(txtProperty->paramBits) : 0;
-            
-            int rawValue = bitReader.readNumber(txtProperty->bits);
-            propToAdd->value = rawValue - txtProperty->add;
-            
+        ItemPropertyTxt *txtProperty = ItemDataBase::propertyTxt(id);
+        if (!txtProperty)
+            return corruptedProperties(props, 6, status);
+
+        ItemProperty *propToAdd = new ItemProperty;
+        propToAdd->bitStringOffset = bitReader.pos() + 16; // include 'JM' bit length
+        propToAdd->param = txtProperty->paramBits ? bitReader.readNumber(txtProperty->paramBits) : 0;
+        
+        int rawValue = bitReader.readNumber(txtProperty->bits);
+        propToAdd->value = rawValue - txtProperty->add;
+        
 #ifndef QT_NO_DEBUG
-            qDebug() << QString("ItemParser: Parsed prop ID=%1, rawValue=%2, add=%3, finalValue=%4, param=%5")
-                       .arg(id)
-                       .arg(rawValue)
-                       .arg(txtProperty->add)
-                       .arg(propToAdd->value)
-                       .arg(propToAdd->param);
+        qDebug() << QString("ItemParser: Parsed prop ID=%1, rawValue=%2, add=%3, finalValue=%4, param=%5")
+                   .arg(id)
+                   .arg(rawValue)
+                   .arg(txtProperty->add)
+                   .arg(propToAdd->value)
+                   .arg(propToAdd->param);
 #endif
-            
-            if (id == ItemProperties::EnhancedDamage)
-            {
-                qint16 minEnhDamage = bitReader.readNumber(txtProperty->bits) - txtProperty->add;
-                if (minEnhDamage < propToAdd->value) // it shouldn't be possible (they must always be equal), but let's make sure
-                    propToAdd->value = minEnhDamage;
-                propToAdd->displayString = kEnhancedDamageFormat().arg(propToAdd->value);
-            }
+        
+        if (id == ItemProperties::EnhancedDamage)
+        {
+            qint16 minEnhDamage = bitReader.readNumber(txtProperty->bits) - txtProperty->add;
+            if (minEnhDamage < propToAdd->value) // it shouldn't be possible (they must always be equal), but let's make sure
+                propToAdd->value = minEnhDamage;
+            propToAdd->displayString = kEnhancedDamageFormat().arg(propToAdd->value);
+        }
 
-            // elemental damage
-            if (   id == ItemProperties::MinimumDamageFire || id == ItemProperties::MinimumDamageLightning || id == ItemProperties::MinimumDamageMagic
-                || id == ItemProperties::MinimumDamageCold || id == ItemProperties::MinimumDamagePoison)
-            {
-                bool hasLength = false;
-                if (id == ItemProperties::MinimumDamageCold || id == ItemProperties::MinimumDamagePoison)
-                    hasLength = true; // length is present only when min damage is specified
-                props.insert(id++, propToAdd);
+        // elemental damage
+        uint traits = ItemDataBase::propertyTraits(id);
+        if (traits & ItemDataBase::ElementalMinDamageTrait)
+        {
+            bool hasLength = (traits & ItemDataBase::DurationTrait) != 0; // length is present only when min damage is specified
+            props.insert(id++, propToAdd);
+
+            // get max elemental damage
+            ItemProperty *maxElementalDamageProp = new ItemProperty;
+            maxElementalDamageProp->bitStringOffset = bitReader.pos() + 16; // include 'JM' bit length
 
-                // get max elemental damage
-                ItemProperty *maxElementalDamageProp = new ItemProperty;
-                maxElementalDamageProp->bitStringOffset = bitReader.pos() + 16; // include 'JM' bit length
+            ItemPropertyTxt *txtMaxElementalDamageProp = ItemDataBase::propertyTxt(id);
+            maxElementalDamageProp->value = bitReader.readNumber(txtMaxElementalDamageProp->bits) - txtMaxElementalDamageProp->add;
+            props.insert(id, maxElementalDamageProp);
 
-                ItemPropertyTxt *txtMaxElementalDamageProp = ItemDataBase::Properties()->value(id);
-                maxElementalDamageProp->value = bitReader.readNumber(txtMaxElementalDamageProp->bits) - txtMaxElementalDamageProp->add;
-                props.insert(id, maxElementalDamageProp);
+            if (hasLength) // cold or poison length
+            {
+                ItemPropertyTxt *lengthProp = ItemDataBase::propertyTxt(++id);
+                qint16 length = bitReader.readNumber(lengthProp->bits) - lengthProp->add;
+                //propToAdd->displayString = QString(" with length of %1 frames (%2 second(s))").arg(length).arg(static_cast<double>(length) / 25.0, 1);
+                //propToAdd->value = length;
+                //props[id] = propToAdd;
 
-                if (hasLength) // cold or poison length
+                if (id == ItemProperties::DurationPoison)
                 {
-                    ItemPropertyTxt *lengthProp = ItemDataBase::Properties()->value(++id);
-                    qint16 length = bitReader.readNumber(lengthProp->bits) - lengthProp->add;
-                    //propToAdd->displayString = QString(" with length of %1 frames (%2 second(s))").arg(length).arg(static_cast<double>(length) / 25.0, 1);
-                    //propToAdd->value = length;
-                    //props[id] = propToAdd;
-
-                    if (id == ItemProperties::DurationPoison)
-                    {
-                        // set correct min/max poison damage
-                        props.replace(id - 1, new ItemProperty(qRound(maxElementalDamageProp->value * length / 256.0), length));
-                        props.replace(id - 2, new ItemProperty(qRound(             propToAdd->value * length / 256.0), length));
-
-                        delete maxElementalDamageProp;
-                        delete propToAdd;
-                    }
-                }
+                    // set correct min/max poison damage
+                    props.replace(id - 1, new ItemProperty(qRound(maxElementalDamageProp->value * length / 256.0), length));
+                    props.replace(id - 2, new ItemProperty(qRound(             propToAdd->value * length / 256.0), length));
 
-                continue;
+                    delete maxElementalDamageProp;
+                    delete propToAdd;
+                }
             }
 
-            createDisplayStringForPropertyWithId(id, propToAdd);
-            props.insert(id, propToAdd);
+            if (bitReader.hasError())
+                return corruptedProperties(props, bitReader.error(), status);
+            continue;
         }
-        catch (int exceptionCode)
+
+        if (bitReader.hasError())
         {
             delete propToAdd;
-            qDebug("caught exception while parsing item properties: %d", exceptionCode);
-            *status = ItemInfo::Corrupted;
-            // Requirements txtProperty has the lowest descpriority, so it'll appear at the bottom
-            props.insert(ItemProperties::Requirements, new ItemProperty(tr("Error parsing item properties (exception == %1), please report!").arg(exceptionCode)));
-            return props;
+            return corruptedProperties(props, bitReader.error(), status);
         }
+
+        createDisplayStringForPropertyWithId(id, propToAdd);
+        props.insert(id, propToAdd);
     }
 
     *status = ItemInfo::Failed;
     return PropertiesMultiMap();
 }
 
+PropertiesMultiMap ItemParser::corruptedProperties(PropertiesMultiMap &props, int errorCode, ItemInfo::ParsingStatus *status)
+{
+    qDebug("error while parsing item properties: %d", errorCode);
+    *status = ItemInfo::Corrupted;
+    // Requirements txtProperty has the lowest descpriority, so it'll appear at the bottom
+    props.insert(Enums::ItemProperties::Requirements, new ItemProperty(tr("Error parsing item properties (exception == %1), please report!").arg(errorCode)));
+    return props;
+}
+
 void ItemParser::createDisplayStringForPropertyWithId(int id, ItemProperty *prop)
 {
 #ifdef Q_CC_CLANG
@@ -488,32 +717,116 @@ void ItemParser::createDisplayStringForPropertyWithId(int id, ItemProperty *prop
         prop->displayString = tr("Level %1 %2 (%3/%4 Charges)").arg(prop->param & 63).arg(ItemDataBase::Skills()->value(prop->param >> 6)->name).arg(prop->value & 255).arg(prop->value >> 8);
     else if (ItemDataBase::isCtcProperty(id))
     {
-        QString desc = ItemDataBase::Properties()->value(id)->descPositive;
+        QString desc = ItemDataBase::propertyTxt(id)->descPositive;
         for (int i = 0, k = 1; k <= 3 && i < desc.length(); ++i)
             if (desc.at(i) == '%' && desc.at(i + 1).isLetter())
                 desc[++i] = QString::number(k++).at(0);
         prop->displayString = desc.replace("%%", "%").arg(prop->value).arg(prop->param & 63).arg(ItemDataBase::Skills()->value(prop->param >> 6)->name);
     }
-    else if (ItemDataBase::MysticOrbs()->contains(id))
-        prop->displayString = QString("%1 x '%2'").arg(prop->value).arg(mysticOrbReadableProperty(ItemDataBase::Items()->value(ItemDataBase::MysticOrbs()->value(id)->itemCode)->spelldesc));
+    else if (ItemDataBase::isMysticOrbProperty(id))
+        prop->displayString = QString("%1 x '%2'").arg(prop->value).arg(mysticOrbReadableProperty(ItemDataBase::itemBase(ItemDataBase::MysticOrbs()->value(id)->itemCode)->spelldesc));
 }
 
 
 void ItemParser::writeItems(const ItemsList &items, QDataStream &ds)
+{
+    QByteArray itemsBytes(itemsBytesCount(items), 0);
+    writeItemsBytes(items, itemsBytes.data());
+    writeByteArrayDataWithoutNull(ds, itemsBytes);
+}
+
+int ItemParser::itemsBytesCount(const ItemsList &items)
+{
+    int bytesCount = 0;
+    foreach (ItemInfo *item, items)
+        bytesCount += kItemHeader.size() + item->bitString.bytesCount() + itemsBytesCount(item->socketablesInfo);
+    return bytesCount;
+}
+
+char *ItemParser::writeItemsBytes(const ItemsList &items, char *dest)
 {
     foreach (ItemInfo *item, items)
     {
-        writeByteArrayDataWithoutNull(ds, kItemHeader);
+        memcpy(dest, kItemHeader.constData(), kItemHeader.size());
+        dest += kItemHeader.size();
 
-        QByteArray itemBytes;
-        for (int i = 0, n = item->bitString.length(); i < n; i += 8)
-            itemBytes.prepend(item->bitString.mid(i, 8).toShort(0, 2));
-        writeByteArrayDataWithoutNull(ds, itemBytes);
+        item->bitString.writeBytes(dest);
+        dest += item->bitString.bytesCount();
 
-        writeItems(item->socketablesInfo, ds);
+        dest = writeItemsBytes(item->socketablesInfo, dest);
 
         item->hasChanged = false;
     }
+    return dest;
+}
+
+// Items whose bits are still the fileBytes they were parsed from are copied without encoding, adjacent ones at once.
+// Everything else (changed, created or moved items, bits read from another file or an older copy of fileBytes) is written like writeItemsBytes() does.
+QByteArray ItemParser::itemsBytes(const ItemsList &items, const QByteArray &fileBytes, int *copiedItemsCount /*= 0*/)
+{
+    QByteArray bytes(itemsBytesCount(items), 0);
+    char *dest = bytes.data();
+    const char *fileData = fileBytes.constData();
+    int copiedItems = 0, runOffset = -1, runEnd = -1;
+    foreach (ItemInfo *item, items)
+    {
+        int itemEnd = item->fileOffset;
+        bool isUnchanged = item->fileOffset >= 0 && item->fileOffset + item->fileBytesCount <= fileBytes.size()
+                && isItemStoredAt(item, fileData, &itemEnd) && itemEnd == item->fileOffset + item->fileBytesCount;
+        if (runOffset != -1 && (!isUnchanged || item->fileOffset != runEnd))
+        {
+            memcpy(dest, fileData + runOffset, runEnd - runOffset);
+            dest += runEnd - runOffset;
+            runOffset = -1;
+        }
+
+        if (isUnchanged)
+        {
+            if (runOffset == -1)
+                runOffset = item->fileOffset;
+            runEnd = itemEnd;
+            ++copiedItems;
+        }
+        else
+            dest = writeItemsBytes(ItemsList() << item, dest);
+    }
+    if (runOffset != -1)
+        memcpy(dest, fileData + runOffset, runEnd - runOffset);
+
+    if (copiedItemsCount)
+        *copiedItemsCount = copiedItems;
+    return bytes;
+}
+
+int ItemParser::rebindItems(const ItemsList &items, const QByteArray &fileBytes, int offset)
+{
+    ItemsBuffer buffer(fileBytes);
+    foreach (ItemInfo *item, items)
+    {
+        item->fileOffset = offset;
+        offset += kItemHeader.size();
+
+        int bytesCount = item->bitString.bytesCount();
+        item->bitString = ItemBitBuffer::fromBuffer(buffer, offset, bytesCount);
+        offset = rebindItems(item->socketablesInfo, fileBytes, offset + bytesCount);
+
+        item->fileBytesCount = offset - item->fileOffset;
+        item->hasChanged = false;
+    }
+    return offset;
+}
+
+// true if the item and its socketables are unchanged and their bits follow each other in fileData from *offset, which is moved past them
+bool ItemParser::isItemStoredAt(const ItemInfo *item, const char *fileData, int *offset)
+{
+    if (item->hasChanged || item->bitString.sharedBytes() != fileData + *offset + kItemHeader.size())
+        return false;
+
+    *offset += kItemHeader.size() + item->bitString.bytesCount();
+    foreach (ItemInfo *socketableItem, item->socketablesInfo)
+        if (!isItemStoredAt(socketableItem, fileData, offset))
+            return false;
+    return true;
 }
 
 QString ItemParser::itemStorageAndCoordinatesString(const QString &text, ItemInfo *item, quint32 plugyPage /*= 0*/)
@@ -521,20 +834,29 @@ QString ItemParser::itemStorageAndCoordinatesString(const QString &text, ItemInf
     return text.arg(ItemsViewerDialog::tabNameAtIndex(ItemsViewerDialog::tabIndexFromItemStorage(item->storage))).arg(item->row + 1).arg(item->column + 1).arg(item->plugyPage ? item->plugyPage : (plugyPage ? plugyPage : item->whereEquipped));
 }
 
+// types unknown to itemtypes.dat match only themselves
 bool ItemParser::itemTypesInheritFromType(const QList<QByteArray> &itemTypes, const QByteArray &allowedItemType)
 {
-    return itemTypesInheritFromTypes(itemTypes, QList<QByteArray>() << allowedItemType);
+    int allowedTypeId = ItemDataBase::itemTypeId(allowedItemType);
+    foreach (const QByteArray &itemType, itemTypes)
+        if (itemType == allowedItemType || ItemDataBase::itemTypeInheritsFrom(ItemDataBase::itemTypeId(itemType), allowedTypeId))
+            return true;
+    return false;
 }
 
 bool ItemParser::itemTypeInheritsFromTypes(const QByteArray &itemType, const QList<QByteArray> &allowedItemTypes)
 {
-    return itemTypesInheritFromTypes(QList<QByteArray>() << itemType, allowedItemTypes);
+    int typeId = ItemDataBase::itemTypeId(itemType);
+    foreach (const QByteArray &allowedItemType, allowedItemTypes)
+        if (itemType == allowedItemType || ItemDataBase::itemTypeInheritsFrom(typeId, ItemDataBase::itemTypeId(allowedItemType)))
+            return true;
+    return false;
 }
 
 bool ItemParser::itemTypesInheritFromTypes(const QList<QByteArray> &itemTypes, const QList<QByteArray> &allowedItemTypes)
 {
     foreach (const QByteArray &itemType, itemTypes)
-        if (allowedItemTypes.contains(itemType) || itemTypesInheritFromTypes(ItemDataBase::ItemTypes()->value(itemType).baseItemTypes, allowedItemTypes))
+        if (itemTypeInheritsFromTypes(itemType, allowedItemTypes))
             return true;
     return false;
 }
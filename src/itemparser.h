@@ -2,6 +2,7 @@
 #define ITEMPARSER_H
 
 #include "structs.h"
+#include "itemview.h"
 
 #include <QCoreApplication>
 
@@ -20,17 +21,45 @@ public:
 
     static QString parseItemsToBuffer(quint16 itemsTotal, QDataStream &inputDataStream, const QByteArray &bytes, const QString &corruptedItemFormat, ItemsList *itemsBuffer, quint32 plugyPage = 0);
     static ItemInfo *parseItem(QDataStream &inputDataStream, const QByteArray &bytes, bool isLastItemOnPlugyPage = false);
-    static PropertiesMultiMap parseItemProperties(ReverseBitReader &bitReader, ItemInfo::ParsingStatus *status);
+    static ItemInfo *parseItem(QDataStream &inputDataStream, const ItemsBuffer &buffer, bool isLastItemOnPlugyPage = false); // item bits share the buffer
+    static ItemView parseItemView(const ItemsBuffer &buffer, int headerOffset); // null view if the item can't be read by its structure
+    // appends views of itemsTotal items starting at the 'JM' at *offset, each one followed by its socketables, and moves *offset past them.
+    // Returns false on the first item that can't be read by its structure, damaged data needs parseItemsToBuffer()
+    static bool parseItemViews(const ItemsBuffer &buffer, int *offset, int itemsTotal, QList<ItemView> *views);
+    static PropertiesMultiMap parseItemProperties(ReverseBitReader &bitReader, ItemInfo::ParsingStatus *status); // bitReader must use StickyErrors
     static void createDisplayStringForPropertyWithId(int id, ItemProperty *prop);
+    static void setCharmPropertiesDisplayStrings(PropertiesMultiMap &props, const QByteArray &itemType);
+
+    // when on, items get only their property lists checked on load and ItemInfo::props/rwProps are decoded on first access
+    static bool isLazyPropertiesDecoding() { return _isLazyPropertiesDecoding; }
+    static void setLazyPropertiesDecoding(bool isLazy) { _isLazyPropertiesDecoding = isLazy; }
+    static void decodePropertyLists(LazyPropertyLists *lists);
 
     static bool itemTypesInheritFromType(const QList<QByteArray> &itemTypes, const QByteArray &allowedItemType);
     static bool itemTypeInheritsFromTypes(const QByteArray &itemType, const QList<QByteArray> &allowedItemTypes);
     static bool itemTypesInheritFromTypes(const QList<QByteArray> &itemTypes, const QList<QByteArray> &allowedItemTypes);
 
     static void writeItems(const ItemsList &items, QDataStream &ds);
+    static int itemsBytesCount(const ItemsList &items); // 'JM' headers and socketables included
+    static char *writeItemsBytes(const ItemsList &items, char *dest); // writes itemsBytesCount() bytes, returns the end
+    static QByteArray itemsBytes(const ItemsList &items, const QByteArray &fileBytes, int *copiedItemsCount = 0); // same bytes as writeItems(), unchanged items read from fileBytes are copied as is
+    static int rebindItems(const ItemsList &items, const QByteArray &fileBytes, int offset); // items were written to fileBytes at offset, read their bits from there like after loading, returns the end
     static QString itemStorageAndCoordinatesString(const QString &text, ItemInfo *item, quint32 plugyPage = 0);
 
 private:
+    static bool _isLazyPropertiesDecoding;
+
+    static ItemInfo *parseItemByStructure(QDataStream &inputDataStream, const ItemsBuffer &buffer);
+    static int parseItemStructure(ItemInfo *item, const QByteArray &bytes, int headerOffset, bool isLazyPropertiesDecoding);
+    static ItemInfo *parseItemUpToNextHeader(QDataStream &inputDataStream, const QByteArray &bytes, bool isLastItemOnPlugyPage);
+    static bool hasHeaderAt(const QByteArray &bytes, int offset, const QByteArray &header);
+    static bool isItemStoredAt(const ItemInfo *item, const char *fileData, int *offset);
+    static bool parseItemFields(ItemInfo *item, ReverseBitReader &bitReader, ItemInfo::ParsingStatus *status, bool isLazyPropertiesDecoding);
+    static void parseSocketables(ItemInfo *item, QDataStream &inputDataStream, const ItemsBuffer &buffer, bool isLastItemOnPlugyPage);
+    static bool skipItemProperties(ReverseBitReader &bitReader);
+    static bool skipPropertyLists(ReverseBitReader &bitReader, int setListsNumber, bool isRW);
+    static bool readFailed(int errorCode, ItemInfo::ParsingStatus *status);
+    static PropertiesMultiMap corruptedProperties(PropertiesMultiMap &props, int errorCode, ItemInfo::ParsingStatus *status);
     static QString mysticOrbReadableProperty(const QString &fullDescription);
 };
 
@@ -0,0 +1,203 @@
+#include "itemparser.h"
+#include "languagemanager.hpp"
+
+#include <QApplication>
+#include <QBuffer>
+#include <QDataStream>
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QStringList>
+
+#include <cstdio>
+
+#ifdef Q_OS_WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+
+static void ignoreMessages(QtMsgType, const QMessageLogContext &, const QString &) {}
+
+// parses every item that starts at a 'JM' header found in bytes, items that were read are skipped as a whole
+static ItemsList parseAllItems(const QByteArray &bytes)
+{
+    QBuffer buffer;
+    buffer.setData(bytes);
+    buffer.open(QIODevice::ReadOnly);
+    QDataStream ds(&buffer);
+    ds.setByteOrder(QDataStream::LittleEndian);
+
+    ItemsList items;
+    for (int start = bytes.indexOf(ItemParser::kItemHeader); start != -1; )
+    {
+        buffer.seek(start);
+        ItemInfo *item = ItemParser::parseItem(ds, bytes);
+        int next = qMax(static_cast<int>(buffer.pos()), start + ItemParser::kItemHeader.size());
+        if (item)
+            items += item;
+        start = bytes.indexOf(ItemParser::kItemHeader, next);
+    }
+    return items;
+}
+
+// views of the same items, each file is mapped and nothing is copied from it
+static QList<ItemView> parseAllItemViews(const QString &path)
+{
+    ItemsBuffer buffer = ItemsBuffer::mapFile(path);
+    QByteArray bytes = buffer.toByteArray();
+
+    QList<ItemView> views;
+    for (int start = bytes.indexOf(ItemParser::kItemHeader); start != -1; )
+    {
+        int next = start;
+        if (!ItemParser::parseItemViews(buffer, &next, 1, &views))
+            next = start + ItemParser::kItemHeader.size();
+        start = bytes.indexOf(ItemParser::kItemHeader, next);
+    }
+    return views;
+}
+
+// peak resident set size of the process in KB, -1 if it's unknown
+static qint64 peakRss()
+{
+#ifdef Q_OS_WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    return GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)) ? static_cast<qint64>(counters.PeakWorkingSetSize / 1024) : -1;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage))
+        return -1;
+# ifdef Q_OS_MAC
+    return usage.ru_maxrss / 1024; // bytes on macOS
+# else
+    return usage.ru_maxrss;
+# endif
+#endif
+}
+
+static int propertiesCount(const ItemsList &items)
+{
+    int count = 0;
+    foreach (ItemInfo *item, items)
+        count += item->props.size() + item->rwProps.size() + propertiesCount(item->socketablesInfo);
+    return count;
+}
+
+// usage: itemparser_benchmark [--eager | --lazy] [iterations] [dir or file ...], by default loads the saves in 'save' and 'save (2)'
+// Compares eager and lazy property decoding: load time, and ItemProperty objects the lazy load doesn't create.
+// Also times read-only ItemView scanning of the mapped files.
+// Peak RSS never goes down, so it's compared by running the two modes as separate processes with --eager and --lazy:
+// the items of all files are then also kept loaded at once, as the main window keeps a character with its stashes.
+int main(int argc, char *argv[])
+{
+    QApplication app(argc, argv);
+    LanguageManager::instance().currentLocale = "en";
+    LanguageManager::instance().setResourcesPath(app.applicationDirPath() + "/../resources");
+    qInstallMessageHandler(ignoreMessages);
+
+    QStringList args = app.arguments().mid(1);
+    int firstMode = 0, lastMode = 1;
+    if (!args.isEmpty() && (args.first() == "--eager" || args.first() == "--lazy"))
+        firstMode = lastMode = args.takeFirst() == "--lazy";
+    int iterations = 20;
+    if (!args.isEmpty() && args.first().toInt() > 0)
+        iterations = args.takeFirst().toInt();
+    if (args.isEmpty())
+        args << "save" << "save (2)";
+
+    QStringList filePaths;
+    QList<QByteArray> files;
+    foreach (const QString &arg, args)
+    {
+        QStringList paths;
+        if (QFileInfo(arg).isDir())
+        {
+            QDirIterator it(arg, QStringList() << "*.d2s" << "*.d2i" << "*.stash" << "*.shared" << "*.d2x" << "*.sss", QDir::Files, QDirIterator::Subdirectories);
+            while (it.hasNext())
+                paths << it.next();
+        }
+        else
+            paths << arg;
+
+        foreach (const QString &path, paths)
+        {
+            QFile f(path);
+            if (f.open(QIODevice::ReadOnly))
+            {
+                files += f.readAll();
+                filePaths += path;
+            }
+            else
+                fprintf(stderr, "can't open %s\n", qPrintable(path));
+        }
+    }
+
+    qDeleteAll(parseAllItems(files.value(0))); // load item database outside of the timing
+
+    for (int lazy = firstMode; lazy <= lastMode; ++lazy)
+    {
+        ItemParser::setLazyPropertiesDecoding(lazy);
+
+        QElapsedTimer timer;
+        timer.start();
+        int itemsCount = 0;
+        for (int i = 0; i < iterations; ++i)
+        {
+            foreach (const QByteArray &bytes, files)
+            {
+                ItemsList items = parseAllItems(bytes);
+                itemsCount += items.size();
+                qDeleteAll(items);
+            }
+        }
+        qint64 loadTime = timer.elapsed();
+
+        // properties are decoded only now in the lazy mode
+        int propsCount = 0;
+        timer.restart();
+        foreach (const QByteArray &bytes, files)
+        {
+            ItemsList items = parseAllItems(bytes);
+            propsCount += propertiesCount(items);
+            qDeleteAll(items);
+        }
+        qint64 accessTime = timer.elapsed();
+
+        printf("%s: %d items in %lld ms (%d iterations), %d properties, first access to all of them after one load %lld ms\n",
+               lazy ? "lazy " : "eager", itemsCount / iterations, loadTime, iterations, propsCount, accessTime);
+    }
+
+    if (firstMode == lastMode)
+    {
+        QList<ItemsList> loadedItems;
+        foreach (const QByteArray &bytes, files)
+            loadedItems += parseAllItems(bytes);
+        printf("%s: peak RSS %lld KB with the items of all files loaded\n", lastMode ? "lazy " : "eager", peakRss());
+        foreach (const ItemsList &items, loadedItems)
+            qDeleteAll(items);
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    int viewsCount = 0;
+    quint32 guidsSum = 0;
+    for (int i = 0; i < iterations; ++i)
+    {
+        foreach (const QString &path, filePaths)
+        {
+            QList<ItemView> views = parseAllItemViews(path);
+            viewsCount += views.size();
+            foreach (const ItemView &view, views)
+                guidsSum += view.guid();
+        }
+    }
+    printf("views: %d items in %lld ms (%d iterations), guid checksum %u\n", viewsCount / iterations, timer.elapsed(), iterations, guidsSum);
+
+    printf("an eager load keeps %d bytes per property in ItemProperty objects and map nodes, display strings excluded\n",
+           static_cast<int>(sizeof(ItemProperty) + sizeof(void *) * 3 + sizeof(int) * 2));
+    return 0;
+}
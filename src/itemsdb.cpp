@@ -0,0 +1,171 @@
+#include "itemsdb.h"
+#include "resourcepathmanager.hpp"
+
+#include <QFile>
+
+#ifdef HAS_QTSQL
+#include <QHash>
+#include <QThread>
+#include <QThreadStorage>
+#include <QUrl>
+#include <QtSql>
+
+
+class ItemsDbConnection
+{
+public:
+    ItemsDbConnection();
+    ~ItemsDbConnection();
+
+    bool isOpen() const { return _db.isOpen(); }
+    bool hasFullTextIndex() const { return _hasFullTextIndex; }
+    QSqlQuery *query(const QString &sql); // prepared on the first call, 0 if the database isn't open or sql is invalid
+
+private:
+    QString _connectionName;
+    QSqlDatabase _db;
+    QHash<QString, QSqlQuery *> _queries;
+    bool _hasFullTextIndex;
+};
+
+// deletes the connection when its thread finishes
+static QThreadStorage<ItemsDbConnection *> connections;
+
+static ItemsDbConnection *connection()
+{
+    if (!connections.hasLocalData())
+        connections.setLocalData(new ItemsDbConnection);
+    return connections.localData();
+}
+
+ItemsDbConnection::ItemsDbConnection() : _connectionName(QString("itemsdb_%1").arg(reinterpret_cast<quintptr>(QThread::currentThreadId()))), _hasFullTextIndex(false)
+{
+    QString fileName = ItemsDb::fileName();
+    if (!QFile::exists(fileName))
+        return;
+
+    _db = QSqlDatabase::addDatabase("QSQLITE", _connectionName);
+    // the database is a resource nobody writes to while the app runs, immutable lets SQLite skip file locking and change detection
+    _db.setConnectOptions("QSQLITE_OPEN_READONLY;QSQLITE_OPEN_URI");
+    _db.setDatabaseName(QUrl::fromLocalFile(fileName).toString() + "?immutable=1");
+    if (!_db.open())
+    {
+        qWarning("error opening items database '%s': %s", qPrintable(fileName), qPrintable(_db.lastError().text()));
+        return;
+    }
+
+    QSqlQuery query(_db);
+    query.exec("PRAGMA query_only = 1");
+    query.exec("PRAGMA mmap_size = 67108864");
+    _hasFullTextIndex = query.exec("SELECT 1 FROM sqlite_master WHERE type = 'table' AND name = 'items_fts'") && query.next();
+}
+
+ItemsDbConnection::~ItemsDbConnection()
+{
+    qDeleteAll(_queries);
+    _queries.clear();
+    if (_db.isValid())
+    {
+        _db.close();
+        _db = QSqlDatabase();
+        QSqlDatabase::removeDatabase(_connectionName);
+    }
+}
+
+QSqlQuery *ItemsDbConnection::query(const QString &sql)
+{
+    if (!isOpen())
+        return 0;
+
+    QSqlQuery *query = _queries.value(sql);
+    if (!query)
+    {
+        query = new QSqlQuery(_db);
+        query->setForwardOnly(true);
+        if (!query->prepare(sql))
+        {
+            qWarning("error preparing items database query '%s': %s", qPrintable(sql), qPrintable(query->lastError().text()));
+            delete query;
+            return 0;
+        }
+        _queries[sql] = query;
+    }
+    return query;
+}
+
+static ItemsDb::Items itemsFromQuery(QSqlQuery *query)
+{
+    ItemsDb::Items items;
+    if (!query)
+        return items;
+    if (!query->exec())
+    {
+        qWarning("error executing items database query: %s", qPrintable(query->lastError().text()));
+        return items;
+    }
+
+    while (query->next())
+    {
+        ItemsDb::Item item;
+        item.code = query->value(0).toString();
+        item.name = query->value(1).toString();
+        if (!item.code.isEmpty())
+            items += item;
+    }
+    query->finish(); // keeps the statement prepared but releases its read transaction
+    return items;
+}
+#endif
+
+
+QString ItemsDb::fileName()
+{
+    return ResourcePathManager::dataPathForFileName("items.db");
+}
+
+bool ItemsDb::isAvailable()
+{
+#ifdef HAS_QTSQL
+    return connection()->isOpen();
+#else
+    return false;
+#endif
+}
+
+ItemsDb::Items ItemsDb::allItems()
+{
+#ifdef HAS_QTSQL
+    return itemsFromQuery(connection()->query("SELECT code, name FROM items ORDER BY rowid"));
+#else
+    return Items();
+#endif
+}
+
+ItemsDb::Items ItemsDb::findItems(const QString &word)
+{
+#ifdef HAS_QTSQL
+    ItemsDbConnection *db = connection();
+    QSqlQuery *query;
+    if (db->hasFullTextIndex())
+    {
+        // prefix query limited to the name and tags columns, the word is quoted so that FTS syntax in it is taken literally
+        query = db->query("SELECT code, name FROM items_fts WHERE items_fts MATCH ? ORDER BY rowid");
+        if (query)
+            query->addBindValue(QString("{name tags} : \"%1\" *").arg(QString(word).replace('"', "\"\"")));
+    }
+    else // database from an older mxl_datac or SQLite without FTS5, matches anywhere in a word
+    {
+        query = db->query("SELECT code, name FROM items WHERE name LIKE ? OR tags LIKE ? ORDER BY rowid");
+        if (query)
+        {
+            QString pattern = "%" + word + "%";
+            query->addBindValue(pattern);
+            query->addBindValue(pattern);
+        }
+    }
+    return itemsFromQuery(query);
+#else
+    Q_UNUSED(word);
+    return Items();
+#endif
+}
@@ -0,0 +1,27 @@
+#ifndef ITEMSDB_H
+#define ITEMSDB_H
+
+#include <QList>
+#include <QString>
+
+
+// Read-only lookups in resources/data/items.db that mxl_datac creates. Every thread opens the database once and keeps
+// the connection with its prepared statements until it exits, so repeated lookups don't pay for opening the file
+// and compiling SQL. Without Qt SQL or the database all lookups return nothing.
+class ItemsDb
+{
+public:
+    struct Item
+    {
+        QString code, name;
+    };
+    typedef QList<Item> Items;
+
+    static QString fileName();
+    static bool isAvailable();
+
+    static Items allItems(); // in the order of items.tsv
+    static Items findItems(const QString &word); // items having a word in their name or tags that starts with 'word', case-insensitive
+};
+
+#endif // ITEMSDB_H
@@ -309,7 +309,7 @@ void ItemsPropertiesSplitter::showContextMenu(const QPoint &pos)
                 while (--runeCode)
                 {
                     QByteArray runeKey = QString("r%1").arg(runeCode, 2, 10, kZeroChar).toLatin1();
-                    ItemBase *base = ItemDataBase::Items()->value(runeKey);
+                    ItemBase *base = ItemDataBase::itemBase(runeKey);
                     QAction *actionRune = new QAction(QIcon(ResourcePathManager::pathForItemImageName(base->imageName)), QString("(%1) %2").arg(base->rlvl).arg(QString(base->name).remove("\\purple;")), _itemsView);
                     actionRune->setData(runeCode);
                     actionRune->setIconVisibleInMenu(true); // explicitly show icon on Mac OS X
@@ -981,7 +981,7 @@ void ItemsPropertiesSplitter::editD2iFile()
             for (auto it = finalItem->props.constBegin(); it != finalItem->props.constEnd(); ++it) {
                 ItemProperty *p = it.value();
                 int id = it.key();
-                ItemPropertyTxt *txt = ItemDataBase::Properties()->value(id);
+                ItemPropertyTxt *txt = ItemDataBase::propertyTxt(id);
                 QString display = p->displayString.isEmpty() ? (txt ? QString::fromUtf8(txt->stat) : tr("Unknown(%1)").arg(id)) : p->displayString;
                 lines << QString("ID=%1 param=%2 value=%3 -> %4").arg(id).arg(p->param).arg(p->value).arg(display);
             }
@@ -1107,7 +1107,7 @@ void ItemsPropertiesSplitter::downgradeSelectedRune()
     quint8 newRuneCode = senderAction->data().toUInt();
     ItemInfo *item = selectedItem();
     item->hasChanged = true;
-    item->itemType = QString("r%1").arg(newRuneCode, 2, 10, kZeroChar).toLatin1();
+    item->setItemType(QString("r%1").arg(newRuneCode, 2, 10, kZeroChar).toLatin1());
     for (int i = 1; i <= 2; ++i)
         ReverseBitWriter::replaceValueInBitString(item->bitString, Enums::ItemOffsets::Type + i*8, item->itemType.at(i));
 
@@ -1154,7 +1154,7 @@ void ItemsPropertiesSplitter::collectShrinesToVessel()
             vesselProp->value = 0;
         vesselProp->value += shrines;
 
-        ItemPropertyTxt *txtProp = ItemDataBase::Properties()->value(Enums::ItemProperties::ShrineVesselCounter);
+        ItemPropertyTxt *txtProp = ItemDataBase::propertyTxt(Enums::ItemProperties::ShrineVesselCounter);
         ReverseBitWriter::replaceValueInBitString(vesselItem->bitString, vesselProp->bitStringOffset, vesselProp->value + txtProp->add, txtProp->bits);
 
         vesselItem->hasChanged = true;
@@ -1183,7 +1183,7 @@ void ItemsPropertiesSplitter::extractShrinesFromVessel()
     ItemInfo *shrine = ItemDataBase::loadItemFromFile("shrine");
     if (shrine->itemType.at(0) != vesselItem->itemType.at(0))
     {
-        shrine->itemType = QByteArray(vesselItem->itemType.constData(), vesselItem->itemType.length() - 1); // e.g. B0+S => B0+
+        shrine->setItemType(QByteArray(vesselItem->itemType.constData(), vesselItem->itemType.length() - 1)); // e.g. B0+S => B0+
         ReverseBitWriter::replaceValueInBitString(shrine->bitString, Enums::ItemOffsets::Type, shrine->itemType.at(0)); // shrines differ only by the first type letter
     }
 
@@ -1209,7 +1209,7 @@ void ItemsPropertiesSplitter::extractShrinesFromVessel()
     }
 
     vesselProp->value -= stored;
-    ItemPropertyTxt *txtProp = ItemDataBase::Properties()->value(Enums::ItemProperties::ShrineVesselCounter);
+    ItemPropertyTxt *txtProp = ItemDataBase::propertyTxt(Enums::ItemProperties::ShrineVesselCounter);
     ReverseBitWriter::replaceValueInBitString(vesselItem->bitString, vesselProp->bitStringOffset, vesselProp->value + txtProp->add, txtProp->bits);
 
     vesselItem->hasChanged = true;
@@ -1227,8 +1227,9 @@ void ItemsPropertiesSplitter::depersonalize()
     ReverseBitWriter::replaceValueInBitString(item->bitString, Enums::ItemOffsets::IsPersonalized, 0);
     item->isPersonalized = false;
 
-    ReverseBitWriter::remove(item->bitString, item->inscribedNameOffset, (item->inscribedName.length() + 1) * ItemParser::kInscribedNameCharacterLength); // also remove trailing \0
-    item->inscribedName.clear();
+    QByteArray &inscribedName = item->rareInfoForWrite().inscribedName;
+    ReverseBitWriter::remove(item->bitString, item->inscribedNameOffset, (inscribedName.length() + 1) * ItemParser::kInscribedNameCharacterLength); // also remove trailing \0
+    inscribedName.clear();
 
     ReverseBitWriter::byteAlignBits(item->bitString);
     item->hasChanged = true;
@@ -1257,8 +1258,9 @@ void ItemsPropertiesSplitter::personalize()
     ReverseBitWriter::replaceValueInBitString(item->bitString, Enums::ItemOffsets::IsPersonalized, 1);
     item->isPersonalized = true;
 
-    item->inscribedName = personalizationName.toLatin1();
-    const char *personalizationNameCstr = item->inscribedName.constData();
+    QByteArray &inscribedName = item->rareInfoForWrite().inscribedName;
+    inscribedName = personalizationName.toLatin1();
+    const char *personalizationNameCstr = inscribedName.constData();
     QString personalizationNameBitString;
     // Build bitstring by appending each character's bits in order (non-destructive)
     for (quint8 i = 0; i < personalizationName.length() + 1; ++i) // trailing \0 must also be written
@@ -1723,7 +1725,7 @@ void ItemsPropertiesSplitter::dumpInfo(ItemInfo *item /*= 0*/, bool shouldShowMs
 {
     if (!item)
         item = selectedItem(false);
-    ItemBase *base = ItemDataBase::Items()->value(item->itemType);
+    ItemBase *base = ItemDataBase::itemBase(item->itemCode());
     const char *quality = metaEnumFromName<Enums::ItemQuality>("ItemQualityEnum").valueToKey(item->quality);
     bool isSetOrUnique = areBothItemsSetOrUnique(item, item); // hacky code :)
 
@@ -2049,7 +2051,7 @@ QHash<QByteArray, UpgradableItemsMultiMap> ItemsPropertiesSplitter::gemsMapsFrom
     QMultiHash<QByteArray, ItemInfo *> allGems;
     foreach (ItemInfo *item, items)
     {
-        QList<QByteArray> types = ItemDataBase::Items()->value(item->itemType)->types;  // first element is gem type, second element is gem grade
+        QList<QByteArray> types = ItemDataBase::itemBase(item->itemCode())->types;  // first element is gem type, second element is gem grade
         if (types.at(0).startsWith("gem") && !types.at(1).endsWith(kPerfectGradeBytes)) // exclude prefect gems
             allGems.insert(types.at(0), item);
     }
@@ -2059,7 +2061,7 @@ QHash<QByteArray, UpgradableItemsMultiMap> ItemsPropertiesSplitter::gemsMapsFrom
     {
         UpgradableItemsMultiMap gemsMap;
         foreach (ItemInfo *gem, allGems.values(gemType))
-            gemsMap.insert(ItemDataBase::Items()->value(gem->itemType)->types.at(1).right(1).toUShort(), gem);
+            gemsMap.insert(ItemDataBase::itemBase(gem->itemCode())->types.at(1).right(1).toUShort(), gem);
         gemsMapsHash[gemType] = gemsMap;
     }
     return gemsMapsHash;
@@ -2114,7 +2116,7 @@ QString ItemsPropertiesSplitter::itemNameBBCode(ItemInfo *item)
 	}
     else if (item->isRW)
     {
-        name = item->rwName;
+        name = item->rareInfo().rwName;
         foreach (ItemInfo *socketable, item->socketablesInfo)
         {
             if (socketable->itemType.startsWith("rx"))
@@ -0,0 +1,524 @@
+// Generated by mxl_datac from itemstatcost.txt, don't edit.
+
+#ifndef ITEMSTATIDS_H
+#define ITEMSTATIDS_H
+
+
+namespace ItemStatIds
+{
+    enum
+    {
+        Strength = 0,
+        Energy = 1,
+        Dexterity = 2,
+        Vitality = 3,
+        Statpts = 4,
+        Newskills = 5,
+        Hitpoints = 6,
+        Maxhp = 7,
+        Mana = 8,
+        Maxmana = 9,
+        Stamina = 10,
+        Maxstamina = 11,
+        Level = 12,
+        Experience = 13,
+        Gold = 14,
+        Goldbank = 15,
+        ItemArmorPercent = 16,
+        ItemMaxdamagePercent = 17,
+        ItemMindamagePercent = 18,
+        Tohit = 19,
+        Toblock = 20,
+        Mindamage = 21,
+        Maxdamage = 22,
+        SecondaryMindamage = 23,
+        SecondaryMaxdamage = 24,
+        Damagepercent = 25,
+        Manarecovery = 26,
+        Manarecoverybonus = 27,
+        Staminarecoverybonus = 28,
+        Lastexp = 29,
+        Nextexp = 30,
+        Armorclass = 31,
+        ArmorclassVsMissile = 32,
+        ArmorclassVsHth = 33,
+        NormalDamageReduction = 34,
+        MagicDamageReduction = 35,
+        Damageresist = 36,
+        Magicresist = 37,
+        Maxmagicresist = 38,
+        Fireresist = 39,
+        Maxfireresist = 40,
+        Lightresist = 41,
+        Maxlightresist = 42,
+        Coldresist = 43,
+        Maxcoldresist = 44,
+        Poisonresist = 45,
+        Maxpoisonresist = 46,
+        Damageaura = 47,
+        Firemindam = 48,
+        Firemaxdam = 49,
+        Lightmindam = 50,
+        Lightmaxdam = 51,
+        Magicmindam = 52,
+        Magicmaxdam = 53,
+        Coldmindam = 54,
+        Coldmaxdam = 55,
+        Coldlength = 56,
+        Poisonmindam = 57,
+        Poisonmaxdam = 58,
+        Poisonlength = 59,
+        Lifedrainmindam = 60,
+        Lifedrainmaxdam = 61,
+        Manadrainmindam = 62,
+        Manadrainmaxdam = 63,
+        Stamdrainmindam = 64,
+        Stamdrainmaxdam = 65,
+        Stunlength = 66,
+        Velocitypercent = 67,
+        Attackrate = 68,
+        OtherAnimrate = 69,
+        Quantity = 70,
+        Value = 71,
+        Durability = 72,
+        Maxdurability = 73,
+        Hpregen = 74,
+        ItemMaxdurabilityPercent = 75,
+        ItemMaxhpPercent = 76,
+        ItemMaxmanaPercent = 77,
+        ItemAttackertakesdamage = 78,
+        ItemGoldbonus = 79,
+        ItemMagicbonus = 80,
+        ItemKnockback = 81,
+        ItemTimeduration = 82,
+        ItemAddclassskills = 83,
+        Unsentparam1 = 84,
+        ItemAddexperience = 85,
+        ItemHealafterkill = 86,
+        ItemReducedprices = 87,
+        AchievementCounts = 88,
+        ItemLightradius = 89,
+        ItemLightcolor = 90,
+        ItemReqPercent = 91,
+        ItemLevelreq = 92,
+        ItemFasterattackrate = 93,
+        ItemLevelreqpct = 94,
+        Lastblockframe = 95,
+        ItemFastermovevelocity = 96,
+        ItemNonclassskill = 97,
+        State = 98,
+        ItemFastergethitrate = 99,
+        MonsterPlayercount = 100,
+        SkillPoisonOverrideLength = 101,
+        ItemFasterblockrate = 102,
+        SkillBypassUndead = 103,
+        SkillBypassDemons = 104,
+        ItemFastercastrate = 105,
+        SkillBypassBeasts = 106,
+        ItemSingleskill = 107,
+        ItemRestinpeace = 108,
+        CurseResistance = 109,
+        ItemPoisonlengthresist = 110,
+        ItemNormaldamage = 111,
+        ItemHowl = 112,
+        ItemStupidity = 113,
+        ItemDamagetomana = 114,
+        ItemIgnoretargetac = 115,
+        ItemFractionaltargetac = 116,
+        ItemPreventheal = 117,
+        ItemHalffreezeduration = 118,
+        ItemTohitPercent = 119,
+        ItemDamagetargetac = 120,
+        ItemDemondamagePercent = 121,
+        ItemUndeaddamagePercent = 122,
+        ItemDemonTohit = 123,
+        ItemUndeadTohit = 124,
+        ItemThrowable = 125,
+        ItemElemskill = 126,
+        ItemAllskills = 127,
+        ItemAttackertakeslightdamage = 128,
+        IronmaidenLevel = 129,
+        LifetapLevel = 130,
+        ThornsPercent = 131,
+        Bonearmor = 132,
+        Bonearmormax = 133,
+        ItemFreeze = 134,
+        ItemOpenwounds = 135,
+        ItemCrushingblow = 136,
+        ItemKickdamage = 137,
+        ItemManaafterkill = 138,
+        ItemHealafterdemonkill = 139,
+        ItemExtrablood = 140,
+        ItemDeadlystrike = 141,
+        ItemAbsorbfirePercent = 142,
+        ItemAbsorbfire = 143,
+        ItemAbsorblightPercent = 144,
+        ItemAbsorblight = 145,
+        ItemAbsorbmagicPercent = 146,
+        ItemAbsorbmagic = 147,
+        ItemAbsorbcoldPercent = 148,
+        ItemAbsorbcold = 149,
+        ItemSlow = 150,
+        ItemAura = 151,
+        ItemIndesctructible = 152,
+        ItemCannotbefrozen = 153,
+        ItemStaminadrainpct = 154,
+        ItemReanimate = 155,
+        ItemPierce = 156,
+        ItemMagicarrow = 157,
+        ItemExplosivearrow = 158,
+        ItemThrowMindamage = 159,
+        ItemThrowMaxdamage = 160,
+        SkillHandofathena = 161,
+        SkillStaminapercent = 162,
+        SkillPassiveStaminapercent = 163,
+        SkillConcentration = 164,
+        SkillEnchant = 165,
+        SkillPierce = 166,
+        SkillConviction = 167,
+        SkillChillingarmor = 168,
+        SkillFrenzy = 169,
+        SkillDecrepify = 170,
+        SkillArmorPercent = 171,
+        Alignment = 172,
+        Target0 = 173,
+        Target1 = 174,
+        Goldlost = 175,
+        ConversionLevel = 176,
+        ConversionMaxhp = 177,
+        UnitDooverlay = 178,
+        AttackVsMontype = 179,
+        DamageVsMontype = 180,
+        Fade = 181,
+        ArmorOverridePercent = 182,
+        ItemDyesColor = 183,
+        XSignet01 = 184,
+        PotionStatCap = 185,
+        PotionSkillCap = 186,
+        StanceID = 187,
+        ItemAddskillTab = 188,
+        DamageDivisor = 189,
+        PassiveUltimative = 190,
+        XSignet02 = 191,
+        XSignet03 = 192,
+        XSignet04 = 193,
+        ItemNumsockets = 194,
+        ItemSkillonattack = 195,
+        ItemSkillonkill = 196,
+        ItemSkillondeath = 197,
+        ItemSkillonhit = 198,
+        ItemSkillonlevelup = 199,
+        ItemMegaimpact = 200,
+        ItemSkillongethit = 201,
+        XSignet05 = 202,
+        ItemTotaldamagePerlevel = 203,
+        ItemChargedSkill = 204,
+        XSignet06 = 205,
+        XSignet07 = 206,
+        XSignet08 = 207,
+        ItemHealonstriking = 208,
+        ItemManaonstriking = 209,
+        SkillHealonstrikingmelee = 210,
+        HexDurSyn = 211,
+        Passivelockout = 212,
+        XSignet09 = 213,
+        ItemArmorPerlevel = 214,
+        ItemArmorpercentPerlevel = 215,
+        ItemHpPerlevel = 216,
+        ItemManaPerlevel = 217,
+        ItemMaxdamagePerlevel = 218,
+        BlessingsCounter = 219,
+        XSignet10 = 220,
+        XSignet11 = 221,
+        XSignet12 = 222,
+        XSignet13 = 223,
+        XSignet14 = 224,
+        ItemTohitpercentPerlevel = 225,
+        XSignet15 = 226,
+        XSignet16 = 227,
+        XSignet17 = 228,
+        XSignet18 = 229,
+        ItemResistColdPerlevel = 230,
+        ItemResistFirePerlevel = 231,
+        ItemResistLtngPerlevel = 232,
+        ItemResistPoisPerlevel = 233,
+        XSignet19 = 234,
+        XSignet20 = 235,
+        XSignet21 = 236,
+        XSignet22 = 237,
+        XSignet23 = 238,
+        ItemFindGoldPerlevel = 239,
+        ItemFindMagicPerlevel = 240,
+        XSignet24 = 241,
+        XSignet25 = 242,
+        XSignet26 = 243,
+        XSignet27 = 244,
+        FfrontProj = 245,
+        FiredanceMod = 246,
+        ItemCrushingblowPerlevel = 247,
+        ItemOpenwoundsPerlevel = 248,
+        XSignet30 = 249,
+        ItemTotembound = 250,
+        XSignet31 = 251,
+        ItemReplenishDurability = 252,
+        ItemReplenishQuantity = 253,
+        ItemExtraStack = 254,
+        XSignet32 = 255,
+        XSignet33 = 256,
+        VesselMod = 257,
+        XSignet35 = 258,
+        ItemDrainAura = 259,
+        ItemThunderfury = 260,
+        NewTotemSyn = 261,
+        PassiveF = 262,
+        XSignet36 = 263,
+        XSignet37 = 264,
+        ItemHealafterplayerkill = 265,
+        ItemWarpBlue = 266,
+        Hotp = 267,
+        BacchaOn = 268,
+        ItemEdyremMark = 269,
+        ItemHasEdyrem = 270,
+        ItemSkillonanydeath = 271,
+        NotUsed272 = 272,
+        ItemCrushthorns = 273,
+        ItemPoisonSet = 274,
+        ItemDescBreaker = 275,
+        ItemNodcht = 276,
+        ItemWarpskillonattack = 277,
+        StrFactor = 278,
+        LionStanceSyn = 279,
+        GreathuntBuff = 280,
+        ItemSupernovaSynergy = 281,
+        ItemSkillondamaged = 282,
+        ItemSkillongetmeleed = 283,
+        ItemSkillongetmissilehit = 284,
+        XSignet38 = 285,
+        XSignet39 = 286,
+        XSignet40 = 287,
+        Si1 = 288,
+        NotUsed289 = 289,
+        NotUsed290 = 290,
+        SkillJustkilledsomeone = 291,
+        ItemSkillonanykill = 292,
+        SkillArcanestrikeSynergy = 293,
+        RunewordLevel = 294,
+        ItemManaonstrikingmelee = 295,
+        ItemIsHonorific = 296,
+        WM = 297,
+        TpLock = 298,
+        StrengthBonusWpn = 299,
+        DexterityBonusWpn = 300,
+        ItemShadowsCorpsesynergy = 301,
+        SkillShadowsAddcorpseonstriking = 302,
+        SkillVoidarchonFire = 303,
+        StatX1 = 304,
+        ItemPierceCold = 305,
+        ItemPierceFire = 306,
+        ItemPierceLtng = 307,
+        ItemPiercePois = 308,
+        SkillCooldownReduce = 309,
+        XSignet46 = 310,
+        XSignet47 = 311,
+        XSignet48 = 312,
+        Darkportal = 313,
+        XSignet50 = 314,
+        Firelength = 315,
+        Burningmin = 316,
+        Burningmax = 317,
+        ProgressiveDamage = 318,
+        ProgressiveSteal = 319,
+        ProgressiveOther = 320,
+        ProgressiveFire = 321,
+        ProgressiveCold = 322,
+        ProgressiveLightning = 323,
+        ItemExtraCharges = 324,
+        ProgressiveTohit = 325,
+        PoisonCount = 326,
+        DamageFramerate = 327,
+        PierceIdx = 328,
+        PassiveFireMastery = 329,
+        PassiveLtngMastery = 330,
+        PassiveColdMastery = 331,
+        PassivePoisMastery = 332,
+        PassiveFirePierce = 333,
+        PassiveLtngPierce = 334,
+        PassiveColdPierce = 335,
+        PassivePoisPierce = 336,
+        PassiveCriticalStrike = 337,
+        PassiveDodge = 338,
+        PassiveAvoid = 339,
+        PassiveEvade = 340,
+        PassiveWarmth = 341,
+        PassiveMasteryMeleeTh = 342,
+        PassiveMasteryMeleeDmg = 343,
+        PassiveMasteryMeleeCrit = 344,
+        PassiveMasteryThrowTh = 345,
+        PassiveMasteryThrowDmg = 346,
+        PassiveMasteryThrowCrit = 347,
+        PassiveWeaponblock = 348,
+        PassiveSummonResist = 349,
+        ModifierlistSkill = 350,
+        ModifierlistLevel = 351,
+        LastSentHpPct = 352,
+        SourceUnitType = 353,
+        SourceUnitId = 354,
+        Shortparam1 = 355,
+        Questitemdifficulty = 356,
+        PassivePmMastery = 357,
+        PassiveMagPierce = 358,
+        ItemStrengthPercent = 359,
+        ItemDexterityPercent = 360,
+        ItemEnergyPercent = 361,
+        ItemVitalityPercent = 362,
+        ItemSlowthorns = 363,
+        ItemHowlthorns = 364,
+        ItemFreezethorns = 365,
+        ItemStupiditythorns = 366,
+        ItemAttackertakescolddamage = 367,
+        ItemAttackertakesfiredamage = 368,
+        XSignet51 = 369,
+        XSignet52 = 370,
+        ItemAmazinggrace = 371,
+        ItemNounsock = 372,
+        PassivePhysPierce = 373,
+        TrapChain = 374,
+        DescTop = 375,
+        ItemSlowOffweapon = 376,
+        DescBottom = 377,
+        DescLessTop = 378,
+        DeathlordPenalty = 379,
+        PassiveBloodlustDmgpct = 380,
+        PassiveBloodlustElempct = 381,
+        XSignet53 = 382,
+        SpecialSyn1 = 383,
+        NearResurrected = 384,
+        DescOrange = 385,
+        WitchberryLifeheal = 386,
+        PassiveMotwDmgpct = 387,
+        PassiveMotwElempct = 388,
+        PassiveMotwDuration = 389,
+        IsEnchanted = 390,
+        PassiveHexAdddmg = 391,
+        Xx420xx = 392,
+        SpecialSyn2 = 393,
+        PassiveShadowsAddelem = 394,
+        WeaponCount = 395,
+        SpecialSyn3 = 396,
+        SpecialSyn4 = 397,
+        YshariEnable = 398,
+        PassiveWrathSynergy = 399,
+        NotUsed400 = 400,
+        NotUsed401 = 401,
+        NotUsed402 = 402,
+        XSignet60 = 403,
+        PassiveFireMasteryPerlevel = 404,
+        PassiveLtngMasteryPerlevel = 405,
+        PassiveColdMasteryPerlevel = 406,
+        PassivePoisMasteryPerlevel = 407,
+        XSignet61 = 408,
+        ProfessionDurationMod = 409,
+        NotUsed410 = 410,
+        NotUsed411 = 411,
+        ResonanceBuff = 412,
+        SkillBloodymaryBonus = 413,
+        SkillEdyremHpPercent = 414,
+        IedDisplay = 415,
+        Passive6 = 416,
+        EleDivisor = 417,
+        ItemNeedschallenged = 418,
+        Goblincurse = 419,
+        EventHit2 = 420,
+        ScosglenCheck = 421,
+        NotUsed422 = 422,
+        NotUsed423 = 423,
+        NotUsed424 = 424,
+        NotUsed425 = 425,
+        NotUsed426 = 426,
+        NotUsed427 = 427,
+        NotUsed428 = 428,
+        NotUsed429 = 429,
+        SkillPaganheartSynergy = 430,
+        SkillPoisonDur = 431,
+        NotUsed432 = 432,
+        Passive1 = 433,
+        Passive2 = 434,
+        Passive3 = 435,
+        Passive4 = 436,
+        Passive5 = 437,
+        AssassinTimerRedPct = 438,
+        ItemHealwhenstruck = 439,
+        ItemManawhenstruck = 440,
+        PassiveAuraAddmax = 441,
+        StrBonusBlue = 442,
+        ItemUpgraded = 443,
+        SkillMinionHpPercent = 444,
+        SkillAncientspiritsSynergy = 445,
+        SkillShamanspathSynergy = 446,
+        TrophyFragmentation = 447,
+        PotionEfficiency = 448,
+        MoonstrikeSynergy = 449,
+        TrophyCounter = 450,
+        HounforActive = 451,
+        CubeUpgrade1 = 452,
+        CubeUpgrade2 = 453,
+        CubeUpgrade3 = 454,
+        CubeUpgrade4 = 455,
+        CharmAuraCrushingblow = 456,
+        Enabler = 457,
+        XSignet62 = 458,
+        XSignet63 = 459,
+        XSignet64 = 460,
+        XSignet65 = 461,
+        SkillVojMastery = 462,
+        ItemClassSpec = 463,
+        SkillScorpionBlades = 464,
+        SkillTotemDamage = 465,
+        TraderChest = 466,
+        RpLock = 467,
+        SkillLightMastery = 468,
+        SkillShadowMastery = 469,
+        SkillMinionDmgPercent = 470,
+        ShamanicDmg = 471,
+        ShamanicLife = 472,
+        LearnEnnead = 473,
+        LearnBlackroad = 474,
+        ItemDescDruidmorph = 475,
+        BlinkDelay = 476,
+        ItemDescHardaura = 477,
+        ItemDescInstructions = 478,
+        SkillMore = 479,
+        ItemSkillParagon = 480,
+        ItemSkillRunemaster = 481,
+        ItemGemParagon = 482,
+        ItemRuneRunemaster = 483,
+        IED = 484,
+        EnrFactor = 485,
+        NotUsed486 = 486,
+        MinionResistAll = 487,
+        EnrFactorPercent = 488,
+        ItemTargettakesdamage = 489,
+        CubeUpgrade5 = 490,
+        CubeUpgrade6 = 491,
+        ItemFasterPotions = 492,
+        SkillSlowrangedthorns = 493,
+        NotUsed494 = 494,
+        StatX3 = 495,
+        TreeSynergy = 496,
+        PactChecker = 497,
+        ItemCotsWhenPact = 498,
+        ItemEnergyPerlevel = 499,
+        ItemMinionAttack = 500,
+        ShrineCounter = 501,
+        BlessedLifeLevel = 502,
+        ItemStrengthPerblessedlife = 503,
+        ItemDexterityPerblessedlife = 504,
+        ItemHpregenPerlevel = 505,
+        DescSuperbeasty = 506,
+        LevelchallengeKillCheck = 507,
+        EqGr = 508,
+        EqGrw = 509
+    };
+}
+
+#endif // ITEMSTATIDS_H
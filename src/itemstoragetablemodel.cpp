@@ -57,7 +57,7 @@ QVariant ItemStorageTableModel::data(const QModelIndex &index, int role) const
         ItemInfo *item = itemAtIndex(index);
         if (item)
         {
-            ItemBase *baseInfo = ItemDataBase::Items()->value(item->itemType);
+            ItemBase *baseInfo = ItemDataBase::itemBase(item->itemCode());
             QString imageName;
             if (item->quality == Enums::ItemQuality::Unique || item->quality == Enums::ItemQuality::Set)
             {
@@ -53,7 +53,7 @@ ItemStorageTableModel *ItemStorageTableView::model() const
 
 void ItemStorageTableView::setCellSpanForItem(ItemInfo *item)
 {
-    ItemBase *itemBase = ItemDataBase::Items()->value(item->itemType);
+    ItemBase *itemBase = ItemDataBase::itemBase(item->itemCode());
     if (!(rowSpan(item->row, item->column) == 1 && itemBase->height == 1 && columnSpan(item->row, item->column) == 1 && itemBase->width == 1))
         setSpan(item->row, item->column, itemBase->height, itemBase->width);
 }
@@ -182,7 +182,7 @@ QModelIndex ItemStorageTableView::indexForDragDropEvent(QDropEvent *event) const
 void ItemStorageTableView::updateHighlightIndexesForOriginIndex(const QModelIndex &originIndex) const
 {
     ItemStorageTableModel *model_ = model();
-    ItemBase *dragitemBase = ItemDataBase::Items()->value(_draggedItem->itemType);
+    ItemBase *dragitemBase = ItemDataBase::itemBase(_draggedItem->itemCode());
     QModelIndexList highlightIndexes;
     highlightIndexes += originIndex;
     for (int i = 0; i < dragitemBase->width; ++i)
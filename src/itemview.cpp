@@ -0,0 +1,143 @@
+#include "itemview.h"
+#include "itemparser.h"
+
+#include <QBuffer>
+#include <QDataStream>
+
+
+// bit positions as ItemParser::parseItemFields() reads them, Enums::ItemOffsets values include 16 bits of 'JM'
+static const int kHeaderBits = 16;
+static const int kIsQuestPos = 0, kIsIdentifiedPos = 4, kIsSocketedPos = 11, kIsEarPos = 16, kIsStarterPos = 17, kIsSimplePos = 21, kIsRWPos = 26;
+static const int kSocketablesNumberPos = Enums::ItemOffsets::Type - kHeaderBits + 32, kGuidPos = kSocketablesNumberPos + 3, kIlvlPos = kGuidPos + 32, kQualityPos = kIlvlPos + 7;
+
+static int offsetPos(int offset)
+{
+    return offset - kHeaderBits;
+}
+
+
+bool ItemView::isQuest() const
+{
+    return bits(kIsQuestPos, 1);
+}
+
+bool ItemView::isIdentified() const
+{
+    return bits(kIsIdentifiedPos, 1);
+}
+
+bool ItemView::isSocketed() const
+{
+    return bits(kIsSocketedPos, 1);
+}
+
+bool ItemView::isEar() const
+{
+    return bits(kIsEarPos, 1);
+}
+
+bool ItemView::isStarter() const
+{
+    return bits(kIsStarterPos, 1);
+}
+
+bool ItemView::isExtended() const
+{
+    return !bits(kIsSimplePos, 1);
+}
+
+bool ItemView::isEthereal() const
+{
+    return bits(offsetPos(Enums::ItemOffsets::Ethereal), 1);
+}
+
+bool ItemView::isPersonalized() const
+{
+    return bits(offsetPos(Enums::ItemOffsets::IsPersonalized), 1);
+}
+
+bool ItemView::isRW() const
+{
+    return bits(kIsRWPos, 1);
+}
+
+int ItemView::location() const
+{
+    return bits(offsetPos(Enums::ItemOffsets::Location), Enums::ItemOffsets::offsetLength(Enums::ItemOffsets::Location));
+}
+
+int ItemView::whereEquipped() const
+{
+    return bits(offsetPos(Enums::ItemOffsets::EquipIndex), Enums::ItemOffsets::offsetLength(Enums::ItemOffsets::EquipIndex));
+}
+
+int ItemView::row() const
+{
+    if (location() == Enums::ItemLocation::Belt)
+        return bits(offsetPos(Enums::ItemOffsets::Column), Enums::ItemOffsets::offsetLength(Enums::ItemOffsets::Column)) / ItemParser::kBeltMaxRows;
+    return bits(offsetPos(Enums::ItemOffsets::Row), Enums::ItemOffsets::offsetLength(Enums::ItemOffsets::Row));
+}
+
+int ItemView::column() const
+{
+    int column = bits(offsetPos(Enums::ItemOffsets::Column), Enums::ItemOffsets::offsetLength(Enums::ItemOffsets::Column));
+    return location() == Enums::ItemLocation::Belt ? column % ItemParser::kBeltMaxColumns : column;
+}
+
+int ItemView::storage() const
+{
+    return bits(offsetPos(Enums::ItemOffsets::Storage), Enums::ItemOffsets::offsetLength(Enums::ItemOffsets::Storage));
+}
+
+QByteArray ItemView::itemType() const
+{
+    if (isEar())
+        return QByteArray("ear");
+
+    QByteArray itemType;
+    for (int i = 0; i < 4; ++i)
+        itemType += static_cast<char>(bits(offsetPos(Enums::ItemOffsets::Type) + i * 8, 8));
+    return itemType.trimmed();
+}
+
+int ItemView::socketablesNumber() const
+{
+    return hasExtendedFields() ? bits(kSocketablesNumberPos, 3) : 0;
+}
+
+quint32 ItemView::guid() const
+{
+    return hasExtendedFields() ? bits(kGuidPos, 32) : 0;
+}
+
+int ItemView::ilvl() const
+{
+    return hasExtendedFields() ? bits(kIlvlPos, 7) : 0;
+}
+
+int ItemView::quality() const
+{
+    return hasExtendedFields() ? bits(kQualityPos, 4) : 0;
+}
+
+ItemInfo *ItemView::toItemInfo() const
+{
+    if (isNull())
+        return 0;
+
+    QBuffer device;
+    device.setData(_buffer.toByteArray());
+    device.open(QIODevice::ReadOnly);
+    device.seek(_offset - ItemParser::kItemHeader.size());
+    QDataStream ds(&device);
+    ds.setByteOrder(QDataStream::LittleEndian);
+
+    // the bits still point into the buffer until the item is changed
+    ItemInfo *item = ItemParser::parseItem(ds, _buffer);
+    if (item && item->status != ItemInfo::Ok)
+    {
+        delete item;
+        return 0;
+    }
+    return item;
+}
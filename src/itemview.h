@@ -0,0 +1,57 @@
+#ifndef ITEMVIEW_H
+#define ITEMVIEW_H
+
+#include "itembitbuffer.h"
+
+
+class ItemInfo;
+
+// Read-only item inside an ItemsBuffer: fields are decoded straight from the shared bytes on each call, nothing is copied.
+// Tools that only look at items can keep views of many files at once and call toItemInfo() only for items they change.
+// Views come from ItemParser::parseItemView() and parseItemViews().
+class ItemView
+{
+public:
+    ItemView() : _offset(0), _bytesCount(0) {}
+    ItemView(const ItemsBuffer &buffer, int offset, int bytesCount) : _buffer(buffer), _offset(offset), _bytesCount(bytesCount) {}
+
+    bool isNull() const { return _buffer.isNull(); }
+    const ItemsBuffer &buffer() const { return _buffer; }
+    int offset() const { return _offset; } // first byte after 'JM'
+    int bytesCount() const { return _bytesCount; }
+    const char *constData() const { return _buffer.constData() + _offset; }
+    quint64 bits(int pos, int length) const { return ItemBitBuffer::bitsFromBytes(constData(), pos, length); }
+    ItemBitBuffer bitString() const { return ItemBitBuffer::fromBuffer(_buffer, _offset, _bytesCount); }
+
+    bool isQuest() const;
+    bool isIdentified() const;
+    bool isSocketed() const;
+    bool isEar() const;
+    bool isStarter() const;
+    bool isExtended() const;
+    bool isEthereal() const;
+    bool isPersonalized() const;
+    bool isRW() const;
+    int location() const;
+    int whereEquipped() const;
+    int row() const;
+    int column() const;
+    int storage() const;
+    QByteArray itemType() const;
+    // fields below are 0 for ears and simple items
+    int socketablesNumber() const;
+    quint32 guid() const;
+    int ilvl() const;
+    int quality() const;
+
+    bool isSameItem(const ItemView &other) const { return isExtended() && guid() == other.guid() && itemType() == other.itemType(); }
+    ItemInfo *toItemInfo() const; // full mutable copy with socketables, the caller owns it, 0 if the item can't be parsed
+
+private:
+    ItemsBuffer _buffer;
+    int _offset, _bytesCount;
+
+    bool hasExtendedFields() const { return !isEar() && isExtended(); }
+};
+
+#endif // ITEMVIEW_H
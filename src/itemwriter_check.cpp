@@ -0,0 +1,121 @@
+#include "itemparser.h"
+
+#include <QCoreApplication>
+#include <QBuffer>
+#include <QDataStream>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QStringList>
+
+#include <cstdio>
+
+
+// the string-based writer ItemParser::writeItems used before ItemInfo::bitString became packed
+static void writeItemFromString(const QString &bitString, QByteArray &out)
+{
+    out += ItemParser::kItemHeader;
+
+    QByteArray itemBytes;
+    for (int i = 0, n = bitString.length(); i < n; i += 8)
+        itemBytes.prepend(bitString.mid(i, 8).toShort(0, 2));
+    out += itemBytes;
+}
+
+// usage: itemwriter_check [dir or file ...], by default checks 'save' and 'save (2)'
+// Every chunk between 'JM' headers is written by both writers, whole and with its highest (index % 8) bits cut
+// to cover sizes that aren't a multiple of 8, every third item also gets the next one as a socketable.
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QStringList args = app.arguments().mid(1);
+    if (args.isEmpty())
+        args << "save" << "save (2)";
+
+    QStringList paths;
+    foreach (const QString &arg, args)
+    {
+        if (QFileInfo(arg).isDir())
+        {
+            QDirIterator it(arg, QStringList() << "*.d2s" << "*.d2i" << "*.stash" << "*.shared" << "*.d2x" << "*.sss", QDir::Files, QDirIterator::Subdirectories);
+            while (it.hasNext())
+                paths << it.next();
+        }
+        else
+            paths << arg;
+    }
+
+    int itemsChecked = 0, filesFailed = 0;
+    foreach (const QString &path, paths)
+    {
+        QFile f(path);
+        if (!f.open(QIODevice::ReadOnly))
+        {
+            fprintf(stderr, "can't open %s\n", qPrintable(path));
+            ++filesFailed;
+            continue;
+        }
+        QByteArray bytes = f.readAll();
+
+        QList<QString> bitStrings;
+        QList<QList<QString> > socketableStrings;
+        ItemsList items;
+        for (int start = bytes.indexOf(ItemParser::kItemHeader), index = 0; start != -1; ++index)
+        {
+            int next = bytes.indexOf(ItemParser::kItemHeader, start + 2);
+            QByteArray itemBytes = bytes.mid(start + 2, next == -1 ? -1 : next - start - 2);
+            start = next;
+
+            QString bitString;
+            for (int i = 0; i < itemBytes.size(); ++i)
+                bitString.prepend(QString("%1").arg(static_cast<quint8>(itemBytes.at(i)), 8, 2, QChar('0')));
+            ItemBitBuffer bits = ItemBitBuffer::fromBytes(itemBytes);
+
+            int cutBits = qMin(index % 8, bits.size());
+            bitString.remove(0, cutBits);
+            bits.resize(bits.size() - cutBits);
+
+            if (index % 3 == 2 && !items.isEmpty())
+            {
+                items.last()->socketablesInfo += new ItemInfo(bits);
+                socketableStrings.last() += bitString;
+            }
+            else
+            {
+                items += new ItemInfo(bits);
+                bitStrings += bitString;
+                socketableStrings += QList<QString>();
+            }
+            ++itemsChecked;
+        }
+
+        QByteArray expected;
+        for (int i = 0; i < bitStrings.size(); ++i)
+        {
+            writeItemFromString(bitStrings.at(i), expected);
+            foreach (const QString &socketableString, socketableStrings.at(i))
+                writeItemFromString(socketableString, expected);
+        }
+
+        QByteArray actual;
+        QBuffer buffer(&actual);
+        buffer.open(QIODevice::WriteOnly);
+        QDataStream ds(&buffer);
+        ItemParser::writeItems(items, ds);
+        buffer.close();
+
+        if (actual != expected || actual.size() != ItemParser::itemsBytesCount(items))
+        {
+            int i = 0;
+            while (i < qMin(actual.size(), expected.size()) && actual.at(i) == expected.at(i))
+                ++i;
+            fprintf(stderr, "%s: output differs at byte %d (%d bytes vs %d expected)\n", qPrintable(path), i, actual.size(), expected.size());
+            ++filesFailed;
+        }
+        qDeleteAll(items);
+    }
+
+    printf("%d files, %d items checked, %d failed\n", paths.size(), itemsChecked, filesFailed);
+    return filesFailed ? 1 : 0;
+}
@@ -256,7 +256,7 @@ ItemInfo* JewelCreationWidget::createJewelItem(const QString &jewelCode)
         // Update itemType to match selected jewel if needed
         if (jewel->itemType != jewelCode.toUtf8()) {
             qDebug() << "Updating itemType from" << jewel->itemType << "to" << jewelCode;
-            jewel->itemType = jewelCode.toUtf8();
+            jewel->setItemType(jewelCode.toUtf8());
             
             // Update itemType in bitString
             for (int i = 0; i < jewel->itemType.length() && i < 4; i++) {
@@ -295,7 +295,7 @@ ItemInfo* JewelCreationWidget::createBasicJewel(const QString &jewelCode)
         ItemInfo *jewel = new ItemInfo();
         
         // Set basic properties
-        jewel->itemType = jewelCode.toUtf8();
+        jewel->setItemType(jewelCode.toUtf8());
         jewel->storage = Enums::ItemStorage::Inventory;
         jewel->location = Enums::ItemLocation::Stored;
         jewel->row = _targetRow;
@@ -11,6 +11,7 @@
 #include "reversebitwriter.h"
 #include "itemparser.h"
 #include "reversebitreader.h"
+#include "bitwriter.h"
 #include "itemspropertiessplitter.h"
 #include "characterinfo.hpp"
 #include "fileassociationmanager.h"
@@ -19,6 +20,7 @@
 #include "skilltreedialog.h"
 #include "allstatsdialog.h"
 #include "dupescandialog.h"
+#include "savetransaction.h"
 
 #include <QCloseEvent>
 #include <QDropEvent>
@@ -38,6 +40,15 @@
 #include <QDateTime>
 #include <QFileSystemWatcher>
 #include <QDesktopServices>
+#include <QFutureWatcher>
+
+#if IS_QT5
+#include <QtConcurrent/QtConcurrentMap>
+#include <QtConcurrent/QtConcurrentRun>
+#else
+#include <QtConcurrentMap>
+#include <QtConcurrentRun>
+#endif
 
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
@@ -124,7 +135,7 @@ MedianXLOfflineTools::MedianXLOfflineTools(const QString &cmdPath, LaunchMode la
     _backupLimitsGroup(new QActionGroup(this)), _showDisenchantPreviewGroup(new QActionGroup(this)), _isLoaded(false), kHackerDetected(tr("1337 hacker detected! Please, play legit.")),
     maxValueFormat(tr("Max: %1")), minValueFormat(tr("Min: %1")), investedValueFormat(tr("Invested: %1")),
     kForumThreadHtmlLinks(QString("<a href=\"https://forum.median-xl.com/viewtopic.php?f=40&t=342\">%1</a><br><a href=\"http://worldofplayers.ru/threads/34489/\">%2</a>").arg(tr("Official Median XL Forum thread"), tr("Official Russian Median XL Forum thread"))),
-    _fsWatcher(new QFileSystemWatcher(this)), _fileChangeTimer(0), _isFileChangedMessageBoxRunning(false)
+    _fsWatcher(new QFileSystemWatcher(this)), _fileChangeTimer(0), _isFileChangedMessageBoxRunning(false), _dataWarmUpWatcher(new QFutureWatcher<void>(this)), _saveVerifyWatcher(new QFutureWatcher<QString>(this))
 {
     ui->setupUi(this);
 
@@ -233,6 +244,11 @@ MedianXLOfflineTools::MedianXLOfflineTools(const QString &cmdPath, LaunchMode la
 #ifndef DUPE_CHECK
     Q_UNUSED(launchMode);
 
+    // the files of a save interrupted by a crash must be all new or all old before any of them is read
+    SaveTransaction interruptedSave;
+    if (!interruptedSave.recover())
+        ERROR_BOX(tr("Error writing file '%1'").arg(QDir::toNativeSeparators(interruptedSave.errorFileName())) + "\n" + tr("Reason: %1", "error with file").arg(interruptedSave.errorString()));
+
     if (!cmdPath.isEmpty())
         loadFile(cmdPath);
     else if (ui->actionLoadLastUsedCharacter->isChecked() && !_recentFilesList.isEmpty())
@@ -440,6 +456,27 @@ void MedianXLOfflineTools::updateFindResults()
         _findItemsDialog->sortAndUpdateSearchResult();
 }
 
+void MedianXLOfflineTools::dataWarmedUp()
+{
+    foreach (const QString &error, ItemDataBase::takeLoadErrors())
+        ERROR_BOX(error);
+}
+
+void MedianXLOfflineTools::savedFilesVerified()
+{
+    QString errors = _saveVerifyWatcher->result();
+    if (errors.isEmpty() || !_isLoaded)
+        return;
+
+    if (QUESTION_BOX_YESNO(tr("Saved files don't match the character in the editor:\n%1\n\nDo you want to reload them?").arg(errors), QMessageBox::Yes) == QMessageBox::Yes)
+    {
+        bool oldStashReloadValue = ui->actionReloadSharedStashes->isChecked();
+        ui->actionReloadSharedStashes->setChecked(true);
+        reloadCharacter();
+        ui->actionReloadSharedStashes->setChecked(oldStashReloadValue);
+    }
+}
+
 void MedianXLOfflineTools::dupeScanFinished()
 {
     _saveFileContents.clear();
@@ -466,6 +503,49 @@ void MedianXLOfflineTools::reloadCharacter(bool shouldNotify /*= true*/)
     loadSaveFile(_charPath, shouldNotify, tr("Character reloaded"));
 }
 
+// a stash written by saveCharacter(), stashes are encoded in parallel and their items are rebound to the new bytes once the save is committed
+struct SavedStash
+{
+    PlugyStashInfo *info;
+    ItemsList items;
+    QByteArray bytes;
+    QVector<ItemsList> pagesItems;
+    QVector<int> pagesItemsOffsets;
+    int itemsCount;
+};
+
+static void encodeStash(SavedStash &stash)
+{
+    ItemsList::const_iterator maxPageIter = std::max_element(stash.items.constBegin(), stash.items.constEnd(), compareItemsByPlugyPage);
+    quint32 lastItemsPage = maxPageIter == stash.items.constEnd() ? 1 : (*maxPageIter)->plugyPage;
+
+    QDataStream plugyFileDataStream(&stash.bytes, QIODevice::WriteOnly);
+    plugyFileDataStream.setByteOrder(QDataStream::LittleEndian);
+    plugyFileDataStream << stash.info->version;
+    plugyFileDataStream << stash.info->activePage;
+
+    stash.pagesItems.resize(lastItemsPage); // one pass over the items instead of one per page
+    foreach (ItemInfo *item, stash.items)
+        if (item->plugyPage)
+            stash.pagesItems[item->plugyPage - 1] += item;
+    stash.pagesItemsOffsets.resize(lastItemsPage);
+    stash.itemsCount = 0;
+
+    for (quint32 page = 1; page <= lastItemsPage; ++page)
+    {
+        writeByteArrayDataWithoutNull(plugyFileDataStream, ItemParser::kPlugyPageHeader);
+        plugyFileDataStream << page - 1;
+        writeByteArrayDataWithoutNull(plugyFileDataStream, ItemParser::kItemHeader);
+
+        // items of untouched pages are contiguous in the loaded file, so such a page is a single copy
+        const ItemsList &pageItems = stash.pagesItems.at(page - 1);
+        plugyFileDataStream << static_cast<quint16>(pageItems.size());
+        stash.pagesItemsOffsets[page - 1] = plugyFileDataStream.device()->pos();
+        writeByteArrayDataWithoutNull(plugyFileDataStream, ItemParser::itemsBytes(pageItems, stash.info->fileContents));
+        stash.itemsCount += pageItems.size();
+    }
+}
+
 void MedianXLOfflineTools::saveCharacter()
 {
     CharacterInfo &charInfo = CharacterInfo::instance();
@@ -480,37 +560,51 @@ void MedianXLOfflineTools::saveCharacter()
     ui->freeStatPointsLineEdit->setText(QString::number(totalPossibleStatPoints(charInfo.basicInfo.level, kDifficultiesNumber)));
 #endif
 
+    // charInfo keeps the offsets in _saveFileContents until all files are written
     QByteArray tempFileContents(_saveFileContents);
+    int skillsOffset = charInfo.skillsOffset, itemsOffset = charInfo.itemsOffset, itemsEndOffset = charInfo.itemsEndOffset;
+#ifdef MAKE_FINISHED_CHARACTER
+    bool shouldReload = true;
+#else
+    bool shouldReload = false; // set if anything besides items and mercenary changes, reloading the file updates all UI at once
+#endif
     if (_isLoaded) // this portion is untouched when saving through command line
     {
         QByteArray statsBytes = statisticBytes();
         if (statsBytes.isEmpty())
             return;
 
-        tempFileContents.replace(Enums::Offsets::StatsData, charInfo.skillsOffset - Enums::Offsets::StatsData, statsBytes);
-        int diff = Enums::Offsets::StatsData + statsBytes.size() - charInfo.skillsOffset;
-        charInfo.skillsOffset = Enums::Offsets::StatsData + statsBytes.size();
-        charInfo.itemsOffset += diff;
-        charInfo.itemsEndOffset += diff;
+        if (statsBytes != _saveFileContents.mid(Enums::Offsets::StatsData, skillsOffset - Enums::Offsets::StatsData))
+            shouldReload = true;
+        tempFileContents.replace(Enums::Offsets::StatsData, skillsOffset - Enums::Offsets::StatsData, statsBytes);
+        int diff = Enums::Offsets::StatsData + statsBytes.size() - skillsOffset;
+        skillsOffset = Enums::Offsets::StatsData + statsBytes.size();
+        itemsOffset += diff;
+        itemsEndOffset += diff;
     }
 
     if (ui->respecSkillsCheckBox->isChecked())
     {
-        int skills = charInfo.itemsOffset - ItemParser::kItemHeader.length() - charInfo.skillsOffset - kSkillsHeader.length();
-        tempFileContents.replace(charInfo.skillsOffset + kSkillsHeader.length(), skills, QByteArray(skills, 0));
+        shouldReload = true;
+        int skills = itemsOffset - ItemParser::kItemHeader.length() - skillsOffset - kSkillsHeader.length();
+        tempFileContents.replace(skillsOffset + kSkillsHeader.length(), skills, QByteArray(skills, 0));
     }
 
 #ifndef MAKE_FINISHED_CHARACTER
     if (ui->activateWaypointsCheckBox->isChecked())
 #endif
     {
+        shouldReload = true;
         QByteArray activatedWaypointsBytes(22, 0xFF);
         for (int startPos = Enums::Offsets::WaypointsData + 2, i = 0; i < kDifficultiesNumber; ++i, startPos += 24)
             tempFileContents.replace(startPos, activatedWaypointsBytes.size(), activatedWaypointsBytes);
     }
 
     if (ui->convertToSoftcoreCheckBox->isChecked())
+    {
+        shouldReload = true;
         charInfo.basicInfo.isHardcore = false;
+    }
 
 #ifdef MAKE_HC
     charInfo.basicInfo.isHardcore = true;
@@ -532,6 +626,8 @@ void MedianXLOfflineTools::saveCharacter()
         statusValue |= Enums::StatusBits::IsLadder;
     else
         statusValue &= ~Enums::StatusBits::IsLadder;
+    if (statusValue != tempFileContents.at(Enums::Offsets::Status))
+        shouldReload = true;
     tempFileContents[Enums::Offsets::Status] = statusValue;
 
     QDataStream outputDataStream(&tempFileContents, QIODevice::ReadWrite);
@@ -582,6 +678,7 @@ void MedianXLOfflineTools::saveCharacter()
 #endif
 
 #ifdef ENABLE_PERSONALIZE
+    shouldReload = true;
     for (int i = 0; i < kDifficultiesNumber; ++i)
     {
         outputDataStream.device()->seek(Enums::Offsets::QuestsData + i * Enums::Quests::Size + Enums::Quests::Nihlathak);
@@ -593,6 +690,7 @@ void MedianXLOfflineTools::saveCharacter()
     bool hasNameChanged = !newName.isEmpty() && charInfo.basicInfo.originalName != newName;
     if (hasNameChanged)
     {
+        shouldReload = true;
         outputDataStream.device()->seek(Enums::Offsets::Name);
 #ifdef Q_OS_MAC
         QByteArray newNameByteArray = ColorsManager::macTextCodec()->fromUnicode(newName);
@@ -612,6 +710,7 @@ void MedianXLOfflineTools::saveCharacter()
         if (charInfo.basicInfo.level != newClvl)
 #endif
         {
+            shouldReload = true;
             charInfo.basicInfo.level = newClvl;
             charInfo.basicInfo.totalSkillPoints = ui->freeSkillPointsLineEdit->text().toUShort();
             recalculateStatPoints();
@@ -632,7 +731,6 @@ void MedianXLOfflineTools::saveCharacter()
         }
     }
 
-    int characterItemsSize = 2, mercItemsSize = 0;
     ItemsList characterItems, mercItems, ironGolemItems;
     QHash<Enums::ItemStorage::ItemStorageEnum, ItemsList> plugyItemsHash;
     
@@ -658,12 +756,10 @@ void MedianXLOfflineTools::saveCharacter()
         }
         else
         {
-            int *pItemsSize = 0;
             ItemsList *pItems = 0;
             switch (item->location)
             {
             case Enums::ItemLocation::Merc:
-                pItemsSize = &mercItemsSize;
                 pItems = &mercItems;
                 item->location = Enums::ItemLocation::Equipped;
                 break;
@@ -675,19 +771,12 @@ void MedianXLOfflineTools::saveCharacter()
                 }
                 break;
             default:
-                pItemsSize = &characterItemsSize;
                 pItems = &characterItems;
                 break;
             }
 
             if (pItems)
                 pItems->append(item);
-            if (pItemsSize)
-            {
-                *pItemsSize += ItemParser::kItemHeader.length() + item->bitString.length() / 8;
-                foreach (ItemInfo *socketableItem, item->socketablesInfo)
-                    *pItemsSize += ItemParser::kItemHeader.length() + socketableItem->bitString.length() / 8;
-            }
         }
     }
 
@@ -706,23 +795,33 @@ void MedianXLOfflineTools::saveCharacter()
              << "Merc:" << mercItems.size() << "(runes:" << mercRuneCount << ")"
              << "Golem:" << ironGolemItems.size() << "(runes:" << golemRuneCount << ")";
 
-    // write character items
-    tempFileContents.replace(charInfo.itemsOffset, charInfo.itemsEndOffset - charInfo.itemsOffset, QByteArray(characterItemsSize, 0));
-    outputDataStream.device()->seek(charInfo.itemsOffset); //-V807
+    // write character items, only changed and new ones are encoded, the rest is copied from the loaded file
+    int copiedItemsCount;
+    QByteArray characterItemsBytes = ItemParser::itemsBytes(characterItems, _saveFileContents, &copiedItemsCount);
+    tempFileContents.replace(itemsOffset + 2, itemsEndOffset - itemsOffset - 2, characterItemsBytes);
+    outputDataStream.device()->seek(itemsOffset); //-V807
     outputDataStream << static_cast<quint16>(characterItems.size());
-    qDebug() << "SAVE: Writing" << characterItems.size() << "character items to file";
-    ItemParser::writeItems(characterItems, outputDataStream);
+    outputDataStream.skipRawData(characterItemsBytes.size());
+    itemsEndOffset = itemsOffset + 2 + characterItemsBytes.size();
+    qDebug() << "SAVE: Writing" << characterItems.size() << "character items to file," << copiedItemsCount << "of them unchanged";
 
     // write merc items
     outputDataStream.skipRawData(ItemParser::kItemHeader.length() + 2 + kMercHeader.length()); // JM + 0 corpses + merc header
+    int mercItemsOffset = -1;
     if (charInfo.mercenary.exists)
     {
         writeByteArrayDataWithoutNull(outputDataStream, ItemParser::kItemHeader);
         outputDataStream << static_cast<quint16>(mercItems.size());
-        int pos = outputDataStream.device()->pos();
-        tempFileContents.replace(pos, tempFileContents.indexOf(kIronGolemHeader, pos) - pos, QByteArray(mercItemsSize, 0));
-        ItemParser::writeItems(mercItems, outputDataStream);
+        mercItemsOffset = outputDataStream.device()->pos();
+        QByteArray mercItemsBytes = ItemParser::itemsBytes(mercItems, _saveFileContents);
+        tempFileContents.replace(mercItemsOffset, tempFileContents.indexOf(kIronGolemHeader, mercItemsOffset) - mercItemsOffset, mercItemsBytes);
+        outputDataStream.skipRawData(mercItemsBytes.size());
     }
+    // they're stored as equipped in the file
+    foreach (ItemInfo *item, mercItems)
+        item->location = Enums::ItemLocation::Merc;
+    foreach (ItemInfo *item, ironGolemItems)
+        item->location = Enums::ItemLocation::IronGolem;
 
     // write possibly deleted golem item
     if (ironGolemItems.isEmpty())
@@ -740,8 +839,9 @@ void MedianXLOfflineTools::saveCharacter()
 
     _fsWatcher->removePaths(_fsWatcher->files());
 
-    // save plugy stashes if changed
+    // encode changed stashes, they don't depend on each other
     QStringList backupedFiles;
+    QList<SavedStash> savedStashes;
     for (QHash<Enums::ItemStorage::ItemStorageEnum, PlugyStashInfo>::iterator iter = _plugyStashesHash.begin(); iter != _plugyStashesHash.end(); ++iter)
     {
         const ItemsList &items = plugyItemsHash[iter.key()];
@@ -761,31 +861,13 @@ void MedianXLOfflineTools::saveCharacter()
             info.version = 1;
             info.activePage = 0;
         }
-        if (!inputFile.open(QIODevice::WriteOnly))
-        {
-            showErrorMessageBoxForFile(tr("Error creating file '%1'"), inputFile);
-            continue;
-        }
-
-        ItemsList::const_iterator maxPageIter = std::max_element(items.constBegin(), items.constEnd(), compareItemsByPlugyPage);
-        quint32 lastItemsPage = maxPageIter == items.constEnd() ? 1 : (*maxPageIter)->plugyPage;
 
-        QDataStream plugyFileDataStream(&inputFile);
-        plugyFileDataStream.setByteOrder(QDataStream::LittleEndian);
-        plugyFileDataStream << info.version;
-        plugyFileDataStream << info.activePage;
-
-        for (quint32 page = 1; page <= lastItemsPage; ++page)
-        {
-            writeByteArrayDataWithoutNull(plugyFileDataStream, ItemParser::kPlugyPageHeader);
-            plugyFileDataStream << page - 1;
-            writeByteArrayDataWithoutNull(plugyFileDataStream, ItemParser::kItemHeader);
-
-            ItemsList pageItems = ItemDataBase::extractItemsFromPage(items, page);
-            plugyFileDataStream << static_cast<quint16>(pageItems.size());
-            ItemParser::writeItems(pageItems, plugyFileDataStream);
-        }
+        SavedStash stash;
+        stash.info = &info;
+        stash.items = items;
+        savedStashes += stash;
     }
+    QtConcurrent::blockingMap(savedStashes, encodeStash);
 
     // save the character
     QString savePath, fileName, saveFileName;
@@ -813,75 +895,110 @@ void MedianXLOfflineTools::saveCharacter()
     else
         outputFile.setFileName(_charPath);
 
-    if (outputFile.open(QIODevice::WriteOnly))
+    // either all files are replaced or none
+    SaveTransaction transaction;
+    foreach (const SavedStash &stash, savedStashes)
+        transaction.addFile(stash.info->path, stash.bytes);
+    transaction.addFile(outputFile.fileName(), tempFileContents);
+    if (!transaction.commit())
     {
-        int bytesWritten = outputFile.write(tempFileContents);
-        if (bytesWritten == static_cast<int>(fileSize)) // shut the compiler up
-        {
-            outputFile.flush();
-            outputFile.close(); // without this explicit call QFileSystemWatcher will report the file as modified after the method returns
-            if (!_isLoaded)
-                return;
-            _saveFileContents = tempFileContents;
+        CUSTOM_BOX_OK(critical, tr("Error writing file '%1'").arg(QDir::toNativeSeparators(transaction.errorFileName())) + "\n" + tr("Reason: %1", "error with file").arg(transaction.errorString()));
+        return;
+    }
+
+    // the files are what was loaded now
+    SavedFiles savedFiles;
+    foreach (const SavedStash &stash, savedStashes)
+    {
+        stash.info->exists = true;
+        stash.info->fileContents = stash.bytes;
+        for (int i = 0; i < stash.pagesItems.size(); ++i)
+            ItemParser::rebindItems(stash.pagesItems.at(i), stash.info->fileContents, stash.pagesItemsOffsets.at(i));
+        savedFiles.stashes += qMakePair(stash.info->path, stash.itemsCount);
+    }
 
-            if (hasNameChanged)
+    if (!_isLoaded)
+        return;
+    _saveFileContents = tempFileContents;
+    charInfo.skillsOffset = skillsOffset;
+    charInfo.itemsOffset = itemsOffset;
+    charInfo.itemsEndOffset = itemsEndOffset;
+    ItemParser::rebindItems(characterItems, _saveFileContents, charInfo.itemsOffset + 2);
+    if (mercItemsOffset != -1)
+        ItemParser::rebindItems(mercItems, _saveFileContents, mercItemsOffset);
+
+    if (hasNameChanged)
+    {
+        // delete .d2s and rename all other related files like .d2x, .key, .ma0, etc.
+        bool isOldNameEmpty = QRegExp(QString("[ %1]+").arg(QChar(QChar::Nbsp))).exactMatch(charInfo.basicInfo.originalName);
+        bool hasNonAsciiChars = false;
+        for (int i = 0; i < charInfo.basicInfo.originalName.length(); ++i)
+        {
+            if (charInfo.basicInfo.originalName.at(i).unicode() > 255)
             {
-                // delete .d2s and rename all other related files like .d2x, .key, .ma0, etc.
-                bool isOldNameEmpty = QRegExp(QString("[ %1]+").arg(QChar(QChar::Nbsp))).exactMatch(charInfo.basicInfo.originalName);
-                bool hasNonAsciiChars = false;
-                for (int i = 0; i < charInfo.basicInfo.originalName.length(); ++i)
-                {
-                    if (charInfo.basicInfo.originalName.at(i).unicode() > 255)
-                    {
-                        hasNonAsciiChars = true;
-                        break;
-                    }
-                }
+                hasNonAsciiChars = true;
+                break;
+            }
+        }
 
-                bool isStrangeName = hasNonAsciiChars || isOldNameEmpty;
-                QDir sourceFileDir(savePath, isStrangeName ? "*" : charInfo.basicInfo.originalName + ".*");
-                foreach (const QFileInfo &fileInfo, sourceFileDir.entryInfoList())
-                {
-                    QString extension = fileInfo.suffix();
-                    if ((isStrangeName && fileInfo.baseName() != charInfo.basicInfo.originalName) || extension == kBackupExtension)
-                        continue;
-
-                    QFile sourceFile(fileInfo.canonicalFilePath());
-                    if (extension == kCharacterExtension) // delete
-                    {
-                        if (!sourceFile.remove())
-                            showErrorMessageBoxForFile(tr("Error removing file '%1'"), sourceFile);
-                    }
-                    else // rename
-                    {
-                        if (!sourceFile.rename(fileName + "." + extension) && !isOldNameEmpty)
-                            showErrorMessageBoxForFile(tr("Error renaming file '%1'"), sourceFile);
-                    }
-                }
+        bool isStrangeName = hasNonAsciiChars || isOldNameEmpty;
+        QDir sourceFileDir(savePath, isStrangeName ? "*" : charInfo.basicInfo.originalName + ".*");
+        foreach (const QFileInfo &fileInfo, sourceFileDir.entryInfoList())
+        {
+            QString extension = fileInfo.suffix();
+            if ((isStrangeName && fileInfo.baseName() != charInfo.basicInfo.originalName) || extension == kBackupExtension)
+                continue;
+
+            QFile sourceFile(fileInfo.canonicalFilePath());
+            if (extension == kCharacterExtension) // delete
+            {
+                if (!sourceFile.remove())
+                    showErrorMessageBoxForFile(tr("Error removing file '%1'"), sourceFile);
+            }
+            else // rename
+            {
+                if (!sourceFile.rename(fileName + "." + extension) && !isOldNameEmpty)
+                    showErrorMessageBoxForFile(tr("Error renaming file '%1'"), sourceFile);
+            }
+        }
 
-                _charPath = saveFileName;
-                charInfo.basicInfo.originalName = newName;
+        _charPath = saveFileName;
+        charInfo.basicInfo.originalName = newName;
 
 #ifdef Q_OS_WIN32
-                removeFromWindowsRecentFiles(_recentFilesList.at(0)); // old file doesn't exist any more
+        removeFromWindowsRecentFiles(_recentFilesList.at(0)); // old file doesn't exist any more
 #endif
-                _recentFilesList[0] = saveFileName;
-                updateRecentFilesActions();
-            }
+        _recentFilesList[0] = saveFileName;
+        updateRecentFilesActions();
+    }
 
-            setModified(false);
-            loadFile(_charPath, true, false); // update all UI at once by reloading the file
+    setModified(false);
+    if (shouldReload)
+        loadFile(_charPath, true, false); // update all UI at once by reloading the file
+    else
+    {
+        // items in memory are what was written, so only the file watcher needs to be restored
+        _fsWatcher->addPath(_charPath);
+        foreach (const PlugyStashInfo &info, _plugyStashesHash)
+            if (info.exists && QFile::exists(info.path))
+                _fsWatcher->addPath(info.path);
+        if (_itemsDialog)
+            _itemsDialog->updateItemManagementButtonsState();
 
-            QString text = tr("File '%1' successfully saved!").arg(QDir::toNativeSeparators(saveFileName));
-            if (!backupedFiles.isEmpty())
-                text += kHtmlLineBreak + kHtmlLineBreak + tr("The following backups were created:") + QString("<ul><li>%1</li></ul>").arg(backupedFiles.join("</li><li>"));
-            INFO_BOX(text);
+        if (ui->actionVerifyAfterSave->isChecked())
+        {
+            savedFiles.charPath = _charPath;
+            savedFiles.itemsOffset = charInfo.itemsOffset;
+            savedFiles.itemsEndOffset = charInfo.itemsEndOffset;
+            savedFiles.itemsCount = characterItems.size();
+            _saveVerifyWatcher->setFuture(QtConcurrent::run(&MedianXLOfflineTools::verifySavedFiles, savedFiles));
         }
-        else
-            showErrorMessageBoxForFile(tr("Error writing file '%1'"), outputFile);
     }
-    else
-        showErrorMessageBoxForFile(tr("Error creating file '%1'"), outputFile);
+
+    QString text = tr("File '%1' successfully saved!").arg(QDir::toNativeSeparators(saveFileName));
+    if (!backupedFiles.isEmpty())
+        text += kHtmlLineBreak + kHtmlLineBreak + tr("The following backups were created:") + QString("<ul><li>%1</li></ul>").arg(backupedFiles.join("</li><li>"));
+    INFO_BOX(text);
 }
 
 #ifdef DUPE_CHECK
@@ -1288,6 +1405,11 @@ void MedianXLOfflineTools::dropEvent(QDropEvent *event)
 
 void MedianXLOfflineTools::loadData()
 {
+    // item tables are loaded in the background, a character loaded meanwhile waits only for the tables it needs
+    connect(_dataWarmUpWatcher, SIGNAL(finished()), SLOT(dataWarmedUp()));
+    _dataWarmUpWatcher->setFuture(ItemDataBase::warmUp());
+    connect(_saveVerifyWatcher, SIGNAL(finished()), SLOT(savedFilesVerified()));
+
     loadExpTable();
     loadMercNames();
     loadBaseStats();
@@ -1641,6 +1763,7 @@ void MedianXLOfflineTools::loadSettings()
         ui->actionBackups5->setChecked(true);
 
     ui->actionReloadSharedStashes->setChecked(settings.value("reloadSharedStashes").toBool());
+    ui->actionVerifyAfterSave->setChecked(settings.value("verifyAfterSave").toBool());
     settings.beginGroup("autoOpenSharedStashes");
     ui->actionAutoOpenPersonalStash->setChecked(settings.value("personal", true).toBool());
     ui->actionAutoOpenSharedStash->setChecked(settings.value("shared", true).toBool());
@@ -1676,6 +1799,7 @@ void MedianXLOfflineTools::saveSettings() const
     settings.setValue("backupLimit", _backupLimitsGroup->checkedAction()->data().toInt());
 
     settings.setValue("reloadSharedStashes", ui->actionReloadSharedStashes->isChecked());
+    settings.setValue("verifyAfterSave", ui->actionVerifyAfterSave->isChecked());
     settings.beginGroup("autoOpenSharedStashes");
     settings.setValue("personal", ui->actionAutoOpenPersonalStash->isChecked());
     settings.setValue("shared", ui->actionAutoOpenSharedStash->isChecked());
@@ -2038,14 +2162,7 @@ bool MedianXLOfflineTools::processSaveFile()
     }
 
     int statsSize = charInfo.skillsOffset - Offsets::StatsData;
-    QString statsBitData;
-    statsBitData.reserve(statsSize * 8);
-    for (int i = 0; i < statsSize; ++i)
-    {
-        quint8 aByte;
-        inputDataStream >> aByte;
-        statsBitData.prepend(binaryStringFromNumber(aByte));
-    }
+    inputDataStream.skipRawData(statsSize);
 
     // clear dynamic values
     charInfo.basicInfo.statsDynamicData.clear();
@@ -2054,14 +2171,14 @@ bool MedianXLOfflineTools::processSaveFile()
     const int maxTries = 1000;
     int totalStats = 0;
     bool shouldShowHackWarning = false;
-    ReverseBitReader bitReader(statsBitData);
+    ReverseBitReader bitReader(_saveFileContents.constData() + Offsets::StatsData, statsSize);
     for (; count < maxTries; ++count)
     {
         CharacterStats::StatisticEnum statCode = static_cast<CharacterStats::StatisticEnum>(bitReader.readNumber(CharacterStats::StatCodeLength));
         if (statCode == CharacterStats::End)
             break;
 
-        ItemPropertyTxt *txtProp = ItemDataBase::Properties()->value(statCode);
+        ItemPropertyTxt *txtProp = ItemDataBase::propertyTxt(statCode);
         int statLength = txtProp->bitsSave;
         if (!statLength)
         {
@@ -2440,6 +2557,119 @@ void MedianXLOfflineTools::recalculateStatPoints()
     CharacterInfo::instance().basicInfo.totalStatPoints = investedStatPoints() + ui->freeStatPointsLineEdit->text().toUInt();
 }
 
+// one page of an extended stash: 'STASH', page id, 'JM' and items count, then the items
+struct PlugyStashPage
+{
+    QByteArray bytes; // the whole file
+    int offset, endOffset, parsedEndOffset; // endOffset is where the next page was found, parsedEndOffset is where the items really end
+    quint32 page;
+    Enums::ItemStorage::ItemStorageEnum storage;
+    QString corruptedItemFormat, corruptedItems;
+    ItemsList items;
+};
+
+static int plugyPageHeaderSize()
+{
+    return ItemParser::kPlugyPageHeader.size() + 4 + ItemParser::kItemHeader.size() + 2;
+}
+
+static bool isPlugyPageAt(const QByteArray &bytes, int offset)
+{
+    return bytes.mid(offset, ItemParser::kPlugyPageHeader.size()) == ItemParser::kPlugyPageHeader && bytes.mid(offset + ItemParser::kPlugyPageHeader.size() + 4, ItemParser::kItemHeader.size()) == ItemParser::kItemHeader;
+}
+
+// page offsets are found by searching for headers, an item can contain the same bytes, so parsePlugyStashPage() results must be checked
+static bool findPlugyStashPages(const QByteArray &bytes, int offset, Enums::ItemStorage::ItemStorageEnum storage, const QString &corruptedItemFormat, QList<PlugyStashPage> *pages)
+{
+    for (quint32 page = 1; offset < bytes.size(); ++page)
+    {
+        if (!isPlugyPageAt(bytes, offset))
+            return false;
+
+        int nextPageOffset = offset + plugyPageHeaderSize();
+        while ((nextPageOffset = bytes.indexOf(ItemParser::kPlugyPageHeader, nextPageOffset)) != -1 && !isPlugyPageAt(bytes, nextPageOffset))
+            ++nextPageOffset;
+        if (nextPageOffset == -1)
+            nextPageOffset = bytes.size();
+
+        PlugyStashPage stashPage;
+        stashPage.bytes = bytes;
+        stashPage.offset = offset;
+        stashPage.endOffset = nextPageOffset;
+        stashPage.parsedEndOffset = -1;
+        stashPage.page = page;
+        stashPage.storage = storage;
+        stashPage.corruptedItemFormat = corruptedItemFormat;
+        *pages += stashPage;
+        offset = nextPageOffset;
+    }
+    return true;
+}
+
+static void parsePlugyStashPage(PlugyStashPage &stashPage)
+{
+    QDataStream inputDataStream(stashPage.bytes);
+    inputDataStream.setByteOrder(QDataStream::LittleEndian);
+    inputDataStream.device()->seek(stashPage.offset + plugyPageHeaderSize() - 2);
+
+    quint16 itemsOnPage;
+    inputDataStream >> itemsOnPage;
+    stashPage.corruptedItems = ItemParser::parseItemsToBuffer(itemsOnPage, inputDataStream, stashPage.bytes, stashPage.corruptedItemFormat, &stashPage.items, stashPage.page);
+    stashPage.parsedEndOffset = inputDataStream.device()->pos();
+    foreach (ItemInfo *item, stashPage.items)
+    {
+        item->storage = stashPage.storage;
+        item->plugyPage = stashPage.page;
+    }
+}
+
+QString MedianXLOfflineTools::verifySavedFiles(const SavedFiles &savedFiles)
+{
+    QStringList errors;
+    QString corruptedItemFormat = tr("Corrupted item detected in %1 at (%2,%3) in slot %4");
+
+    QFile charFile(savedFiles.charPath);
+    QByteArray bytes = charFile.open(QIODevice::ReadOnly) ? charFile.readAll() : QByteArray();
+    quint16 itemsTotal = 0;
+    ItemsList items;
+    QString corruptedItems;
+    if (savedFiles.itemsOffset + 2 <= bytes.size())
+    {
+        QDataStream inputDataStream(bytes);
+        inputDataStream.setByteOrder(QDataStream::LittleEndian);
+        inputDataStream.device()->seek(savedFiles.itemsOffset);
+        inputDataStream >> itemsTotal;
+        if (itemsTotal == savedFiles.itemsCount)
+            corruptedItems = ItemParser::parseItemsToBuffer(itemsTotal, inputDataStream, bytes, corruptedItemFormat, &items);
+        if (inputDataStream.device()->pos() != savedFiles.itemsEndOffset)
+            itemsTotal = 0;
+    }
+    if (itemsTotal != savedFiles.itemsCount || items.size() != savedFiles.itemsCount || !corruptedItems.isEmpty())
+        errors += QString("%1 %2").arg(QFileInfo(savedFiles.charPath).fileName(), corruptedItems.trimmed()).trimmed();
+    qDeleteAll(items);
+
+    typedef QPair<QString, int> StashItemsCount;
+    foreach (const StashItemsCount &stash, savedFiles.stashes)
+    {
+        QFile stashFile(stash.first);
+        bytes = stashFile.open(QIODevice::ReadOnly) ? stashFile.readAll() : QByteArray();
+
+        QList<PlugyStashPage> pages;
+        bool isValid = findPlugyStashPages(bytes, 2 * sizeof(quint32), Enums::ItemStorage::NotInStorage, corruptedItemFormat, &pages); // version and active page come first
+        int stashItemsCount = 0;
+        for (int i = 0; i < pages.size(); ++i)
+        {
+            parsePlugyStashPage(pages[i]);
+            isValid = isValid && pages.at(i).parsedEndOffset == pages.at(i).endOffset && pages.at(i).corruptedItems.isEmpty();
+            stashItemsCount += pages.at(i).items.size();
+            qDeleteAll(pages.at(i).items);
+        }
+        if (!isValid || stashItemsCount != stash.second)
+            errors += QFileInfo(stash.first).fileName();
+    }
+    return errors.join("\n");
+}
+
 void MedianXLOfflineTools::processPlugyStash(QHash<Enums::ItemStorage::ItemStorageEnum, PlugyStashInfo>::iterator &iter, ItemsList *items)
 {
     PlugyStashInfo &info = iter.value();
@@ -2454,6 +2684,7 @@ void MedianXLOfflineTools::processPlugyStash(QHash<Enums::ItemStorage::ItemStora
 
     QByteArray bytes = inputFile.readAll();
     inputFile.close();
+    info.fileContents = bytes;
 
     Enums::ItemStorage::ItemStorageEnum plugyStorage = iter.key();
 
@@ -2461,9 +2692,33 @@ void MedianXLOfflineTools::processPlugyStash(QHash<Enums::ItemStorage::ItemStora
     inputDataStream.setByteOrder(QDataStream::LittleEndian);
     inputDataStream >> info.version;
 
-    QString corruptedItems;
+    QString corruptedItems, corruptedItemFormat = tr("Corrupted item detected in %1 on page %4 at (%2,%3)");
     inputDataStream >> info.activePage;
-    for (quint32 page = 1; !inputDataStream.atEnd(); ++page)
+
+    // pages are independent once their offsets are known
+    QList<PlugyStashPage> pages;
+    bool arePagesParsed = findPlugyStashPages(bytes, inputDataStream.device()->pos(), plugyStorage, corruptedItemFormat, &pages);
+    if (arePagesParsed)
+    {
+        QtConcurrent::blockingMap(pages, parsePlugyStashPage);
+        foreach (const PlugyStashPage &stashPage, pages)
+            arePagesParsed = arePagesParsed && stashPage.parsedEndOffset == stashPage.endOffset;
+    }
+    if (arePagesParsed)
+    {
+        foreach (const PlugyStashPage &stashPage, pages)
+        {
+            items->append(stashPage.items);
+            corruptedItems += stashPage.corruptedItems;
+        }
+    }
+    else // damaged file or a page header inside an item, parse page by page to report errors where they are
+    {
+        foreach (const PlugyStashPage &stashPage, pages)
+            qDeleteAll(stashPage.items);
+    }
+
+    for (quint32 page = 1; !arePagesParsed && !inputDataStream.atEnd(); ++page)
     {
         if (bytes.mid(inputDataStream.device()->pos(), ItemParser::kPlugyPageHeader.size()) != ItemParser::kPlugyPageHeader)
         {
@@ -2486,7 +2741,7 @@ void MedianXLOfflineTools::processPlugyStash(QHash<Enums::ItemStorage::ItemStora
         quint16 itemsOnPage;
         inputDataStream >> itemsOnPage;
         ItemsList plugyItems;
-        corruptedItems += ItemParser::parseItemsToBuffer(itemsOnPage, inputDataStream, bytes, tr("Corrupted item detected in %1 on page %4 at (%2,%3)"), &plugyItems, page);
+        corruptedItems += ItemParser::parseItemsToBuffer(itemsOnPage, inputDataStream, bytes, corruptedItemFormat, &plugyItems, page);
         foreach (ItemInfo *item, plugyItems)
         {
             item->storage = plugyStorage;
@@ -2814,7 +3069,8 @@ void MedianXLOfflineTools::updateCharacterExperienceProgressbar(quint32 newExper
 
 QByteArray MedianXLOfflineTools::statisticBytes()
 {
-    QString result;
+    BitWriter result;
+    result.reserve(CharacterInfo::instance().skillsOffset - Enums::Offsets::StatsData);
     QMetaEnum statisticMetaEnum = Enums::CharacterStats::statisticMetaEnum();
     bool isExpAndLevelNotSet = true;
     QList<QVariant> achievements = CharacterInfo::instance().basicInfo.statsDynamicData.values(Enums::CharacterStats::Achievements);
@@ -2861,15 +3117,15 @@ QByteArray MedianXLOfflineTools::statisticBytes()
             quint8 clvl = CharacterInfo::instance().basicInfo.level, newClvl = ui->levelSpinBox->value();
             if (clvl != newClvl) // set new level and experience explicitly
             {
-                addStatisticBits(result, Enums::CharacterStats::Level, Enums::CharacterStats::StatCodeLength);
-                addStatisticBits(result, newClvl, ItemDataBase::Properties()->value(Enums::CharacterStats::Level)->bitsSave);
+                result.writeStatCode(Enums::CharacterStats::Level);
+                result.writeNumber(newClvl, ItemDataBase::propertyTxt(Enums::CharacterStats::Level)->bitsSave);
                 charInfo.setValueForStatistic(newClvl, Enums::CharacterStats::Level);
 
                 quint32 newExp = experienceTable.at(newClvl - 1);
                 if (newExp) // must not be present for level 1 character
                 {
-                    addStatisticBits(result, Enums::CharacterStats::Experience, Enums::CharacterStats::StatCodeLength);
-                    addStatisticBits(result, newExp, ItemDataBase::Properties()->value(Enums::CharacterStats::Experience)->bitsSave);
+                    result.writeStatCode(Enums::CharacterStats::Experience);
+                    result.writeNumber(newExp, ItemDataBase::propertyTxt(Enums::CharacterStats::Experience)->bitsSave);
                 }
                 charInfo.setValueForStatistic(newExp, Enums::CharacterStats::Experience);
 
@@ -2881,7 +3137,7 @@ QByteArray MedianXLOfflineTools::statisticBytes()
         }
         else if (statCode == Enums::CharacterStats::End) // byte align
         {
-            addStatisticBits(result, statCode, 16 - result.length() % 8);
+            result.writeNumber(statCode, 16 - result.bitsCount() % 8);
             break; // not necessary actually
         }
         else
@@ -2890,46 +3146,32 @@ QByteArray MedianXLOfflineTools::statisticBytes()
         if (value || isAchievement)
         {
             if (!isAchievement || !achievements.isEmpty())
-                addStatisticBits(result, statCode, Enums::CharacterStats::StatCodeLength);
+                result.writeStatCode(statCode);
 
-            ItemPropertyTxt *txtProp = ItemDataBase::Properties()->value(statCode);
+            ItemPropertyTxt *txtProp = ItemDataBase::propertyTxt(statCode);
             if (isAchievement && !achievements.isEmpty())
             {
                 QList<QVariant> achievementData = achievements.at(achievementIndex).toList();
                 if (++achievementIndex < achievements.size())
                     --i;
 
-                addStatisticBits(result, achievementData.at(0).toULongLong(), txtProp->paramBitsSave);
+                result.writeNumber(achievementData.at(0).toULongLong(), txtProp->paramBitsSave);
                 value = achievementData.at(1).toULongLong();
             }
             if (value)
-                addStatisticBits(result, value, txtProp->bitsSave);
+                result.writeNumber(value, txtProp->bitsSave);
         }
 
         if (!isAchievement)
             CharacterInfo::instance().setValueForStatistic(value, statCode);
     }
 
-    int bitsCount = result.length();
-    if (bitsCount % 8)
+    if (!result.isByteAligned())
     {
         ERROR_BOX(tr("Stats string is not byte aligned!"));
         return QByteArray();
     }
-
-    QByteArray resultBytes;
-    resultBytes.reserve(bitsCount / 8);
-    for (int startPos = bitsCount - 8; startPos >= 0; startPos -= 8)
-    {
-        quint8 aByte = result.mid(startPos, 8).toUShort(0, 2);
-        resultBytes += aByte;
-    }
-    return resultBytes;
-}
-
-void MedianXLOfflineTools::addStatisticBits(QString &bitsString, quint64 number, int fieldWidth)
-{
-    bitsString.prepend(binaryStringFromNumber(number, false, fieldWidth));
+    return result.bytes();
 }
 
 void MedianXLOfflineTools::clearItems(bool sharedStashPathChanged1 /*= true*/, bool hcStashPathChanged1 /*= true*/, bool sharedStashPathChanged2 /*= true*/, bool hcStashPathChanged2 /*= true*/)
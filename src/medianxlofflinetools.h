@@ -32,6 +32,7 @@ class QTableWidgetItem;
 class QFile;
 class QFileSystemWatcher;
 class QTimer;
+template <typename T> class QFutureWatcher;
 
 class QNetworkAccessManager;
 class QNetworkReply;
@@ -76,6 +77,8 @@ private slots:
 
     void eatSignetsOfLearning(int signetsEaten);
     void updateFindResults();
+    void dataWarmedUp();
+    void savedFilesVerified();
     void dupeScanFinished();
 
     void networkReplyCheckForUpdateFinished(QNetworkReply *reply);
@@ -171,6 +174,17 @@ private:
     QTimer *_fileChangeTimer;
     bool _isFileChangedMessageBoxRunning;
 
+    QFutureWatcher<void> *_dataWarmUpWatcher;
+
+    // what a save without reloading wrote, checked in the background by verifySavedFiles()
+    struct SavedFiles
+    {
+        QString charPath;
+        int itemsOffset, itemsEndOffset, itemsCount; // itemsOffset is right after 'JM'
+        QList<QPair<QString, int> > stashes;          // path and items count
+    };
+    QFutureWatcher<QString> *_saveVerifyWatcher;
+
     // the following group of methods is Windows 7 specific
 #ifdef Q_OS_WIN32
     PCWSTR  appUserModelID();
@@ -237,9 +251,9 @@ private:
     void updateCharacterExperienceProgressbar(quint32 newExperience);
 
     QByteArray statisticBytes();
-    inline void addStatisticBits(QString &bitsString, quint64 number, int fieldWidth);
 
     void processPlugyStash(QHash<Enums::ItemStorage::ItemStorageEnum, PlugyStashInfo>::iterator &iter, ItemsList *items);
+    static QString verifySavedFiles(const SavedFiles &savedFiles); // returns errors
     QHash<int, bool> getPlugyStashesExistenceHash() const;
     void clearItems(bool sharedStashPathChanged1 = true, bool hcStashPathChanged1 = true, bool sharedStashPathChanged2 = true, bool hcStashPathChanged2 = true);
 
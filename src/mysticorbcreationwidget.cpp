@@ -3,6 +3,7 @@
 #include "itemdatabase.h"
 #include "reversebitwriter.h"
 #include "resourcepathmanager.hpp"
+#include "itemsdb.h"
 #include <QVBoxLayout>
 #include <QGridLayout>
 #include <QMessageBox>
@@ -11,9 +12,7 @@
 #include <QComboBox>
 #include <QDir>
 #include <QTextStream>
-#ifdef HAS_QTSQL
-#include <QtSql>
-#endif
+#include <QCoreApplication>
 
 MysticOrbCreationWidget::MysticOrbCreationWidget(QWidget *parent)
     : QDialog(parent), _createdOrb(nullptr), _targetRow(0), _targetCol(0), _copies(1)
@@ -66,30 +65,10 @@ void MysticOrbCreationWidget::setupUI()
 
     _previewLabel->setText(tr("Template: resources/items/47+.d2i"));
 
-    // First try to load orbs from a generated SQLite DB (resources/data/items.db)
-    bool loaded = false;
-#ifdef HAS_QTSQL
-    QString dbPath = QCoreApplication::applicationDirPath() + QStringLiteral("/../resources/data/items.db");
-    if (QFile::exists(dbPath)) {
-        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", "itemsdb_conn");
-        db.setDatabaseName(dbPath);
-        if (db.open()) {
-            QSqlQuery q(db);
-            if (q.exec("SELECT code, name FROM items WHERE name LIKE '%Mystic Orb%' OR name LIKE '%Mystic%' OR tags LIKE '%myst%';")) {
-                while (q.next()) {
-                    QString code = q.value(0).toString();
-                    QString name = q.value(1).toString();
-                    if (!code.isEmpty()) {
-                        _orbCombo->addItem(code + " - " + name, code);
-                    }
-                }
-                if (_orbCombo->count() > 0) loaded = true;
-            }
-            db.close();
-        }
-        QSqlDatabase::removeDatabase("itemsdb_conn");
-    }
-#endif
+    // First try to load orbs from the generated SQLite DB (resources/data/items.db)
+    for (const ItemsDb::Item &item : ItemsDb::findItems(QStringLiteral("myst")))
+        _orbCombo->addItem(item.code + " - " + item.name, item.code);
+    bool loaded = _orbCombo->count() > 0;
 
     if (!loaded) {
         // TSV fallback: best-effort parse from generated items.tsv
@@ -185,7 +164,7 @@ ItemInfo* MysticOrbCreationWidget::createMysticOrbItem()
     item->move(_rowSpin->value(), _colSpin->value(), 0, true);
     item->storage = -1;
     item->hasChanged = true;
-    item->itemType = selectedCode.toUtf8();
+    item->setItemType(selectedCode.toUtf8());
     ReverseBitWriter::byteAlignBits(item->bitString);
     return item;
 }
@@ -73,7 +73,7 @@ void OilCreationWidget::populateOilList()
     };
 
     for (const QString &code : oilCodes) {
-        ItemBase *b = ItemDataBase::Items()->value(code.toUtf8());
+        ItemBase *b = ItemDataBase::itemBase(code.toUtf8());
         QString label = b ? QString("%1 - %2").arg(b->name).arg(code) : code;
         _oilCombo->addItem(label, code);
     }
@@ -82,7 +82,7 @@ void OilCreationWidget::populateOilList()
 void OilCreationWidget::onSelectionChanged()
 {
     QString code = _oilCombo->currentData().toString();
-    ItemBase *b = ItemDataBase::Items()->value(code.toUtf8());
+    ItemBase *b = ItemDataBase::itemBase(code.toUtf8());
     QString txt = QString("<b>%1</b><br>Code: %2<br>Size: %3x%4<br>Req Lvl: %5")
             .arg(b ? b->name : QString("<unknown>"))
             .arg(code)
@@ -159,7 +159,7 @@ ItemInfo* OilCreationWidget::createOilItem(const QString &code)
     item->move(_rowSpin->value(), _colSpin->value(), 0, true);
     item->storage = -1;
     item->hasChanged = true;
-    item->itemType = code.toUtf8();
+    item->setItemType(code.toUtf8());
     ReverseBitWriter::byteAlignBits(item->bitString);
     return item;
 }
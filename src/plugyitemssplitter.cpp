@@ -640,7 +640,7 @@ void PlugyItemsSplitter::sortWearableItems(ItemsList &selectedItems, quint32 &pa
     foreach (ItemInfo *item, selectedItems)
     {
         int key;
-        if (item->isQuest || ItemDataBase::Items()->value(item->itemType)->questId > 0)
+        if (item->isQuest || ItemDataBase::itemBase(item->itemCode())->questId > 0)
             key = Quest;
         else if (item->isRW)
             key = RW;
@@ -764,7 +764,7 @@ void PlugyItemsSplitter::sortWearableQualityItems(ItemsList &selectedItems, quin
                     ItemInfo *item = items.at(i);
                     bool itemShouldBeAdded = false;
 
-                    Enums::ItemTypeGeneric::ItemTypeGenericEnum genericType = ItemDataBase::Items()->value(item->itemType)->genericType;
+                    Enums::ItemTypeGeneric::ItemTypeGenericEnum genericType = ItemDataBase::itemBase(item->itemCode())->genericType;
                     if ((genericType == Enums::ItemTypeGeneric::Weapon || genericType == Enums::ItemTypeGeneric::Armor) && isSacred(item))
                     {
                         // force correct ordering of some items (they don't 'inherit' from tiered versions)
@@ -802,7 +802,7 @@ void PlugyItemsSplitter::sortWearableQualityItems(ItemsList &selectedItems, quin
             QMap<QString, ItemsList> sortedItemsByType; // using QMap instead of QHash to have determined order
             foreach (ItemInfo *item, itemBaseTypeItems)
             {
-                ItemBase *baseInfo = ItemDataBase::Items()->value(item->itemType);
+                ItemBase *baseInfo = ItemDataBase::itemBase(item->itemCode());
                 QString itemName = baseInfo->name, key = itemName.left(itemName.lastIndexOf('(')).trimmed();
                 if (itemBaseType == "hamm")
                 {
@@ -901,7 +901,7 @@ void PlugyItemsSplitter::sortMiscItems(ItemsList &selectedItems, quint32 &page,
                 {
                     // sort gems by type at first using specified order
                     foreach (ItemInfo *item, itemBaseTypeItems)
-                        sortedItemsByType[gemTypesOrderMapping().value(ItemDataBase::Items()->value(item->itemType)->types.first())] << item;
+                        sortedItemsByType[gemTypesOrderMapping().value(ItemDataBase::itemBase(item->itemCode())->types.first())] << item;
                     // to sort gems by quality, sort by rlvl
                     for (QMap<QByteArray, ItemsList>::iterator jter = sortedItemsByType.begin(), endJter = sortedItemsByType.end(); jter != endJter; ++jter)
                     {
@@ -913,7 +913,7 @@ void PlugyItemsSplitter::sortMiscItems(ItemsList &selectedItems, quint32 &page,
                 {
                     // (U)MOs are sorted by image name at first
                     foreach (ItemInfo *item, itemBaseTypeItems)
-                        sortedItemsByType[ItemDataBase::Items()->value(item->itemType)->imageName] << item;
+                        sortedItemsByType[ItemDataBase::itemBase(item->itemCode())->imageName] << item;
                     // and then by type
                     for (QMap<QByteArray, ItemsList>::iterator jter = sortedItemsByType.begin(), endJter = sortedItemsByType.end(); jter != endJter; ++jter)
                     {
@@ -1031,7 +1031,7 @@ void PlugyItemsSplitter::storeItemsOnPage(const ItemsList &items, bool shouldSta
     foreach (ItemInfo *item, items)
     {
         bool isCotw_ = isCotw(item), isNewRow = shouldStartAnotherTypeFromNewRow || (shouldStartAnotherCotwFromNewRow && isCotw_);
-        ItemBase *baseInfo = ItemDataBase::Items()->value(item->itemType);
+        ItemBase *baseInfo = ItemDataBase::itemBase(item->itemCode());
         if (isNewRow)
         {
             if (!previousItem)
@@ -1106,7 +1106,7 @@ QHash<QByteArray, ItemsList> PlugyItemsSplitter::itemsSortedByBaseType(const Ite
     QHash<QByteArray, ItemsList> itemsByBaseType;
     foreach (ItemInfo *item, items)
     {
-        QList<QByteArray> baseTypes = ItemDataBase::Items()->value(item->itemType)->types;
+        QList<QByteArray> baseTypes = ItemDataBase::itemBase(item->itemCode())->types;
         QByteArray baseType = baseTypes.first();
         // sacred belts also have first type 'belt' so that they could display 4 rows of potions
         if (baseType == "belt" && !isTiered(baseTypes))
@@ -34,9 +34,10 @@ QString PropertiesDisplayManager::completeItemDescription(ItemInfo *item, bool u
     QString ilvlText = tr("Item Level: %1").arg(item->ilvl) + "\n";
     if (item->isEar)
     {
-        QString itemDescription = tr("%1's Ear", "param is character name").arg(item->earInfo.name.constData()) + "\n";
-        itemDescription += Enums::ClassName::classes().at(item->earInfo.classCode) + "\n";
-        itemDescription += tr("Level %1").arg(item->earInfo.level);
+        ItemRareInfo rareInfo = item->rareInfo();
+        QString itemDescription = tr("%1's Ear", "param is character name").arg(rareInfo.earInfo.name.constData()) + "\n";
+        itemDescription += Enums::ClassName::classes().at(rareInfo.earInfo.classCode) + "\n";
+        itemDescription += tr("Level %1").arg(rareInfo.earInfo.level);
         return itemDescription + "\n" + ilvlText;
     }
 
@@ -56,12 +57,12 @@ QString PropertiesDisplayManager::completeItemDescription(ItemInfo *item, bool u
     PropertiesMultiMap::iterator iter = allProps.begin();
     while (iter != allProps.end())
     {
-        if (ItemDataBase::MysticOrbs()->contains(iter.key()) && isClassCharm)
+        if (isClassCharm && ItemDataBase::isMysticOrbProperty(iter.key()))
             addChallengeNamesToClassCharm(iter);
         ++iter;
     }
 
-    ItemBase *itemBase = ItemDataBase::Items()->value(item->itemType);
+    ItemBase *itemBase = ItemDataBase::itemBase(item->itemCode());
     foreach (ItemInfo *socketableItem, item->socketablesInfo)
     {
         PropertiesMultiMap socketableProps = socketableProperties(socketableItem, itemBase->socketableType);
@@ -82,7 +83,7 @@ QString PropertiesDisplayManager::completeItemDescription(ItemInfo *item, bool u
 
     QString runes;
     foreach (ItemInfo *socketable, item->socketablesInfo)
-        if (ItemParser::itemTypesInheritFromType(ItemDataBase::Items()->value(socketable->itemType)->types, "rune"))
+        if (ItemParser::itemTypesInheritFromType(ItemDataBase::itemBase(socketable->itemCode())->types, "rune"))
             runes += ItemDataBase::Socketables()->value(socketable->itemType)->letter;
     if (!runes.isEmpty()) // gem-/jewelwords don't have any letters
         itemDescription += QString("%1'%2'\n").arg(useColor ? ColorsManager::colorStrings().at(ColorsManager::Gold) : QString(), runes);
@@ -217,7 +218,7 @@ QString PropertiesDisplayManager::completeItemDescription(ItemInfo *item, bool u
     int maxSocketableRlvl = 0;
     foreach (ItemInfo *socketableItem, item->socketablesInfo)
     {
-        int socketableRlvl = socketableItem->quality == Enums::ItemQuality::Unique ? ItemDataBase::Uniques()->value(socketableItem->setOrUniqueId)->rlvl : ItemDataBase::Items()->value(socketableItem->itemType)->rlvl;
+        int socketableRlvl = socketableItem->quality == Enums::ItemQuality::Unique ? ItemDataBase::Uniques()->value(socketableItem->setOrUniqueId)->rlvl : ItemDataBase::itemBase(socketableItem->itemCode())->rlvl;
         if (maxSocketableRlvl < socketableRlvl)
             maxSocketableRlvl = socketableRlvl;
     }
@@ -399,7 +400,7 @@ void PropertiesDisplayManager::constructPropertyStrings(const PropertiesMultiMap
         {
             displayString += hiddenPropertyText;
 
-            quint8 descPriority = ItemDataBase::Properties()->value(propId)->descPriority;
+            quint8 descPriority = ItemDataBase::propertyTxt(propId)->descPriority;
             propsDisplayMap.insert(descPriority, ItemPropertyDisplay(displayString, descPriority, propId));
         }
     }
@@ -417,7 +418,7 @@ void PropertiesDisplayManager::constructPropertyStrings(const PropertiesMultiMap
     for (QHash<QPair<quint8, quint8>, QString>::const_iterator iter = mergeDamagePropertiesHash.constBegin(); iter != mergeDamagePropertiesHash.constEnd(); ++iter)
     {
         const QPair<quint8, quint8> &elementalPropIdPair = iter.key();
-        ItemPropertyDisplay propMin = propsDisplayMap.value(ItemDataBase::Properties()->value(elementalPropIdPair.first)->descPriority), propMax = propsDisplayMap.value(ItemDataBase::Properties()->value(elementalPropIdPair.second)->descPriority);
+        ItemPropertyDisplay propMin = propsDisplayMap.value(ItemDataBase::propertyTxt(elementalPropIdPair.first)->descPriority), propMax = propsDisplayMap.value(ItemDataBase::propertyTxt(elementalPropIdPair.second)->descPriority);
         if (propMin.propertyId && propMax.propertyId)
         {
             propsDisplayMap.remove(propMin.priority);
@@ -445,7 +446,7 @@ void PropertiesDisplayManager::constructPropertyStrings(const PropertiesMultiMap
     for (QMap<quint8, ItemPropertyDisplay>::iterator iter = propsDisplayMap.begin(); iter != propsDisplayMap.end(); ++iter)
     {
         ItemPropertyDisplay &itemPropDisplay = iter.value();
-        ItemPropertyTxt *itemPropertyTxt = ItemDataBase::Properties()->value(itemPropDisplay.propertyId);
+        ItemPropertyTxt *itemPropertyTxt = ItemDataBase::propertyTxt(itemPropDisplay.propertyId);
         if (!itemPropertyTxt->groupIDs.isEmpty())
         {
             QList<quint16> availableGroupIDs;
@@ -485,7 +486,7 @@ PropertiesDisplayManager::SecondaryDamageUsage PropertiesDisplayManager::seconda
     int damageValue = allProperties.value(damageProperty, foo)->value;
     if (allProperties != item->rwProps)
         foreach (ItemInfo *socketableItem, item->socketablesInfo)
-            damageValue -= socketableProperties(socketableItem, ItemDataBase::Items()->value(item->itemType)->socketableType).value(damageProperty, foo)->value;
+            damageValue -= socketableProperties(socketableItem, ItemDataBase::itemBase(item->itemCode())->socketableType).value(damageProperty, foo)->value;
     delete foo;
 
     if (damageValue)
@@ -496,7 +497,7 @@ PropertiesDisplayManager::SecondaryDamageUsage PropertiesDisplayManager::seconda
 
 QString PropertiesDisplayManager::propertyDisplay(ItemProperty *propDisplay, int propId, bool shouldColor /*= false*/)
 {
-    ItemPropertyTxt *prop = ItemDataBase::Properties()->value(propId);
+    ItemPropertyTxt *prop = ItemDataBase::propertyTxt(propId);
     int value = propDisplay->value;
     if (!value || !prop->descFunc)
         return QString();
@@ -635,8 +636,9 @@ QString PropertiesDisplayManager::propertyDisplay(ItemProperty *propDisplay, int
     {
         if (int formatStringOffset = propDisplay->param & 0xFF)
         {
-            quint32 stringIndex = ItemDataBase::StringTable()->key(description) + formatStringOffset;
-            description = ItemDataBase::StringTable()->value(stringIndex);
+            quint32 stringIndex = ItemDataBase::StringTable()->indexOfValue(description);
+            if (stringIndex != TblStringTable::kNotFound)
+                description = ItemDataBase::StringTable()->value(stringIndex + formatStringOffset);
         }
 
         int statStringOffset = propDisplay->param >> 8;
@@ -658,8 +660,8 @@ QString PropertiesDisplayManager::propertyDisplay(ItemProperty *propDisplay, int
         default:
             return description;
         }
-        quint32 statStrIndex = ItemDataBase::tblIndexLookup.value(QLatin1String("strchrstr")) + statStringOffset;
-        const QByteArray statStrUtf8 = ItemDataBase::StringTable()->value(statStrIndex).toUtf8();
+        quint32 statStrIndex = ItemDataBase::StringTable()->indexOfKey(QLatin1String("strchrstr"));
+        const QByteArray statStrUtf8 = statStrIndex != TblStringTable::kNotFound ? ItemDataBase::StringTable()->value(statStrIndex + statStringOffset).toUtf8() : QByteArray();
 
         int innateElementalDamage = 0; // TODO: computation ignores innate elemental damage stat from all items
 
@@ -65,9 +65,10 @@ void PropertiesViewerWidget::showItem(ItemInfo *item)
     QString ilvlText = kHtmlLineBreak + qApp->translate(kTranslationContext, "Item Level: %1").arg(item->ilvl);
     if (item->isEar)
     {
-        QString itemDescription = qApp->translate(kTranslationContext, "%1's Ear", "param is character name").arg(item->earInfo.name.constData()) + kHtmlLineBreak;
-        itemDescription += ClassName::classes().at(item->earInfo.classCode) + kHtmlLineBreak;
-        itemDescription += qApp->translate(kTranslationContext, "Level %1").arg(item->earInfo.level);
+        ItemRareInfo rareInfo = item->rareInfo();
+        QString itemDescription = qApp->translate(kTranslationContext, "%1's Ear", "param is character name").arg(rareInfo.earInfo.name.constData()) + kHtmlLineBreak;
+        itemDescription += ClassName::classes().at(rareInfo.earInfo.classCode) + kHtmlLineBreak;
+        itemDescription += qApp->translate(kTranslationContext, "Level %1").arg(rareInfo.earInfo.level);
         renderHtml(ui->allTextEdit, itemDescription + ilvlText);
         return;
     }
@@ -92,7 +93,7 @@ void PropertiesViewerWidget::showItem(ItemInfo *item)
     PropertiesMultiMap::iterator iter = allProps.begin();
     while (iter != allProps.end())
     {
-        if (ItemDataBase::MysticOrbs()->contains(iter.key()))
+        if (ItemDataBase::isMysticOrbProperty(iter.key()))
         {
             // !!!: add custom text for charms that use MO codes here
             if (isClassCharm)
@@ -113,7 +114,7 @@ void PropertiesViewerWidget::showItem(ItemInfo *item)
             ++iter;
     }
 
-    ItemBase *itemBase = ItemDataBase::Items()->value(item->itemType);
+    ItemBase *itemBase = ItemDataBase::itemBase(item->itemCode());
     ui->socketablesTextEdit->clear();
     if (!item->socketablesInfo.isEmpty())
     {
@@ -149,7 +150,7 @@ void PropertiesViewerWidget::showItem(ItemInfo *item)
     QString runes;
     foreach (ItemInfo *socketable, item->socketablesInfo)
     {
-        if (ItemParser::itemTypesInheritFromType(ItemDataBase::Items()->value(socketable->itemType)->types, "rune"))
+        if (ItemParser::itemTypesInheritFromType(ItemDataBase::itemBase(socketable->itemCode())->types, "rune"))
         {
             SocketableItemInfo *sock = ItemDataBase::Socketables()->value(socketable->itemType);
             if (sock)
@@ -321,7 +322,7 @@ void PropertiesViewerWidget::showItem(ItemInfo *item)
     int maxSocketableRlvl = 0;
     foreach (ItemInfo *socketableItem, item->socketablesInfo)
     {
-        int socketableRlvl = socketableItem->quality == ItemQuality::Unique ? ItemDataBase::Uniques()->value(socketableItem->setOrUniqueId)->rlvl : ItemDataBase::Items()->value(socketableItem->itemType)->rlvl;
+        int socketableRlvl = socketableItem->quality == ItemQuality::Unique ? ItemDataBase::Uniques()->value(socketableItem->setOrUniqueId)->rlvl : ItemDataBase::itemBase(socketableItem->itemCode())->rlvl;
         if (maxSocketableRlvl < socketableRlvl)
             maxSocketableRlvl = socketableRlvl;
     }
@@ -450,8 +451,8 @@ void PropertiesViewerWidget::renderHtml(QTextEdit *textEdit, const QString &desc
 
 void PropertiesViewerWidget::removeAllMysticOrbs()
 {
-    removeMysticOrbsFromProperties(_itemMysticOrbs, &_item->props);
-    removeMysticOrbsFromProperties(_rwMysticOrbs, &_item->rwProps);
+    removeMysticOrbsFromProperties(_itemMysticOrbs, &_item->props.map());
+    removeMysticOrbsFromProperties(_rwMysticOrbs, &_item->rwProps.map());
 
     ReverseBitWriter::byteAlignBits(_item->bitString);
     updateItem();
@@ -461,7 +462,7 @@ void PropertiesViewerWidget::removeMysticOrb()
 {
     QAction *action = qobject_cast<QAction *>(sender());
     int moCode = action->property("moCode").toInt();
-    PropertiesMultiMap *props = &(action->property("isItemMO").toBool() ? _item->props : _item->rwProps);
+    PropertiesMultiMap *props = &(action->property("isItemMO").toBool() ? _item->props : _item->rwProps).map();
 
     MysticOrb *mo = ItemDataBase::MysticOrbs()->value(moCode);
     int moNumber = props->value(moCode)->value; // must be queried before calling removeMysticOrbData()
@@ -494,7 +495,7 @@ void PropertiesViewerWidget::removeMysticOrbData(int moCode, PropertiesMultiMap
         modifyMysticOrbProperty(statId, moValue, props, mo->param);
 
     // remove MO data
-    ItemPropertyTxt *propertyTxt = ItemDataBase::Properties()->value(moCode);
+    ItemPropertyTxt *propertyTxt = ItemDataBase::propertyTxt(moCode);
     int valueIndex = indexOfPropertyValue(moCode, props);
     if (valueIndex > -1)
         ReverseBitWriter::remove(_item->bitString, valueIndex, propertyTxt->bits + propertyTxt->paramBits + Enums::CharacterStats::StatCodeLength);
@@ -508,7 +509,7 @@ int PropertiesViewerWidget::indexOfPropertyValue(int id, const PropertiesMultiMa
     if (!prop)
         return -1;
 
-    ItemPropertyTxt *property = ItemDataBase::Properties()->value(id);
+    ItemPropertyTxt *property = ItemDataBase::propertyTxt(id);
     qulonglong value = prop->value + property->add;
     int bits = property->bits;
     if (id == Enums::ItemProperties::EnhancedDamage)
@@ -558,7 +559,7 @@ void PropertiesViewerWidget::modifyMysticOrbProperty(int id, int decrement, Prop
 
     // ED value is stored as a sequence of 2 equal values
     bool isEnhancedDamageProp = id == Enums::ItemProperties::EnhancedDamage;
-    ItemPropertyTxt *propertyTxt = ItemDataBase::Properties()->value(id);
+    ItemPropertyTxt *propertyTxt = ItemDataBase::propertyTxt(id);
     int bitsLength = (1 + isEnhancedDamageProp) * propertyTxt->bits;
 
     ItemProperty *prop = getProperty(id, param, props);
@@ -614,7 +615,7 @@ QString PropertiesViewerWidget::collectMysticOrbsDataFromProps(QSet<int> *moSet,
     PropertiesMap::iterator iter = propsWithoutMO.begin();
     while (iter != propsWithoutMO.end())
     {
-        if (ItemDataBase::MysticOrbs()->contains(iter.key()))
+        if (ItemDataBase::isMysticOrbProperty(iter.key()))
         {
             if (!ItemDataBase::isUberCharm(_item))
                 moSet->insert(iter.key());
@@ -650,13 +651,13 @@ quint8 PropertiesViewerWidget::mysticOrbEffectMultiplier() const
     if (_item->props.contains(Enums::ItemProperties::MysticOrbsEffectQuadrupled) || _item->rwProps.contains(Enums::ItemProperties::MysticOrbsEffectQuadrupled))
         return 4;
 
-    const PropertiesMultiMap *propMaps[] = {&_item->props, &_item->rwProps};
+    const PropertiesMultiMap *propMaps[] = {&_item->props.map(), &_item->rwProps.map()};
     for (int i = 0; i < 2; ++i)
     {
         const PropertiesMultiMap *props = propMaps[i];
         for (PropertiesMultiMap::const_iterator it = props->constBegin(); it != props->constEnd(); ++it)
         {
-            ItemPropertyTxt *propTxt = ItemDataBase::Properties()->value(it.key());
+            ItemPropertyTxt *propTxt = ItemDataBase::propertyTxt(it.key());
             if (propTxt && (propTxt->descFunc == 31 || propTxt->descFunc == 34) && it.value()->param == 11514)
                 return 4;
         }
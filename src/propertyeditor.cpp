@@ -153,7 +153,7 @@ void PropertyEditor::setItem(ItemInfo *item)
 #endif
     for (auto it = _item->props.constBegin(); it != _item->props.constEnd(); ++it) {
         // Skip properties with zero value or missing descFunc (same as PropertiesDisplayManager::propertyDisplay)
-        ItemPropertyTxt *propTxt = ItemDataBase::Properties()->value(it.key());
+        ItemPropertyTxt *propTxt = ItemDataBase::propertyTxt(it.key());
         if (it.value()->value == 0 || !propTxt || !propTxt->descFunc) {
 #ifndef QT_NO_DEBUG
             QString reason = it.value()->value == 0 ? "zero value" : 
@@ -186,7 +186,7 @@ void PropertyEditor::setItem(ItemInfo *item)
 #endif
     for (auto it = _item->rwProps.constBegin(); it != _item->rwProps.constEnd(); ++it) {
         // Skip runeword properties with zero value or missing descFunc (same as PropertiesDisplayManager::propertyDisplay)
-        ItemPropertyTxt *propTxt = ItemDataBase::Properties()->value(it.key());
+        ItemPropertyTxt *propTxt = ItemDataBase::propertyTxt(it.key());
         if (it.value()->value == 0 || !propTxt || !propTxt->descFunc) {
 #ifndef QT_NO_DEBUG
             QString reason = it.value()->value == 0 ? "zero value" : 
@@ -210,13 +210,13 @@ void PropertyEditor::setItem(ItemInfo *item)
     // Count actual loaded properties (excluding zero values and missing descFunc)
     int loadedItemProps = 0;
     for (auto it = _item->props.constBegin(); it != _item->props.constEnd(); ++it) {
-        ItemPropertyTxt *propTxt = ItemDataBase::Properties()->value(it.key());
+        ItemPropertyTxt *propTxt = ItemDataBase::propertyTxt(it.key());
         if (it.value()->value != 0 && propTxt && propTxt->descFunc) loadedItemProps++;
     }
     
     int loadedRwProps = 0;
     for (auto it = _item->rwProps.constBegin(); it != _item->rwProps.constEnd(); ++it) {
-        ItemPropertyTxt *propTxt = ItemDataBase::Properties()->value(it.key());
+        ItemPropertyTxt *propTxt = ItemDataBase::propertyTxt(it.key());
         if (it.value()->value != 0 && propTxt && propTxt->descFunc) loadedRwProps++;
     }
     
@@ -510,7 +510,7 @@ void PropertyEditor::updatePropertyRow(PropertyEditorRow *row)
         return;
     }
     
-    ItemPropertyTxt *propTxt = ItemDataBase::Properties()->value(propertyId);
+    ItemPropertyTxt *propTxt = ItemDataBase::propertyTxt(propertyId);
     if (!propTxt) {
         _updatingUI = false;
         return;
@@ -553,7 +553,7 @@ void PropertyEditor::validatePropertyValue(PropertyEditorRow *row)
     int propertyId = row->propertyCombo->currentData().toInt();
     if (propertyId < 0) return;
     
-    ItemPropertyTxt *propTxt = ItemDataBase::Properties()->value(propertyId);
+    ItemPropertyTxt *propTxt = ItemDataBase::propertyTxt(propertyId);
     if (!propTxt) return;
     
     // Check for duplicate properties within the same type (item or runeword)
@@ -691,7 +691,7 @@ void PropertyEditor::validatePropertyValue(PropertyEditorRow *row)
 
 QString PropertyEditor::getPropertyDisplayName(int propertyId) const
 {
-    ItemPropertyTxt *propTxt = ItemDataBase::Properties()->value(propertyId);
+    ItemPropertyTxt *propTxt = ItemDataBase::propertyTxt(propertyId);
     if (!propTxt) return tr("Unknown Property (%1)").arg(propertyId);
     
     QString name;
@@ -710,7 +710,7 @@ QString PropertyEditor::getPropertyDisplayName(int propertyId) const
 
 QPair<int, int> PropertyEditor::getValueRange(int propertyId) const
 {
-    ItemPropertyTxt *propTxt = ItemDataBase::Properties()->value(propertyId);
+    ItemPropertyTxt *propTxt = ItemDataBase::propertyTxt(propertyId);
     if (!propTxt) return QPair<int, int>(-32768, 32767);
     
     // Calculate correct range based on bit storage format
@@ -765,7 +765,7 @@ QPair<int, int> PropertyEditor::getValueRange(int propertyId) const
 
 QPair<quint32, quint32> PropertyEditor::getParameterRange(int propertyId) const
 {
-    ItemPropertyTxt *propTxt = ItemDataBase::Properties()->value(propertyId);
+    ItemPropertyTxt *propTxt = ItemDataBase::propertyTxt(propertyId);
     if (!propTxt || propTxt->paramBits == 0) {
         return QPair<quint32, quint32>(0, 0);
     }
@@ -848,7 +848,7 @@ int PropertyEditor::getDisplayValueForProperty(int propertyId, const ItemPropert
     // Most properties display the stored value directly
     // But some need special handling
     
-    ItemPropertyTxt *propTxt = ItemDataBase::Properties()->value(propertyId);
+    ItemPropertyTxt *propTxt = ItemDataBase::propertyTxt(propertyId);
     if (!propTxt) {
 #ifndef QT_NO_DEBUG
         qDebug() << "PropertyEditor: No property definition found for ID" << propertyId;
@@ -887,7 +887,7 @@ int PropertyEditor::getStorageValueFromDisplay(int propertyId, int displayValue)
     // Convert from display value back to storage value
     // This reverses getDisplayValueForProperty
     
-    ItemPropertyTxt *propTxt = ItemDataBase::Properties()->value(propertyId);
+    ItemPropertyTxt *propTxt = ItemDataBase::propertyTxt(propertyId);
     if (!propTxt) return displayValue;
     
     switch (propertyId) {
@@ -1117,7 +1117,7 @@ void PropertyEditor::applyPropertyChanges()
         existingProp->param = newParameter;
         
         // Update the property in the bit string using ReverseBitWriter with CORRECTED offsets
-        ItemPropertyTxt *propTxt = ItemDataBase::Properties()->value(propertyId);
+        ItemPropertyTxt *propTxt = ItemDataBase::propertyTxt(propertyId);
         if (propTxt && existingProp->bitStringOffset > 16) { // Must be after JM header
             
             qDebug() << "PropertyEditor: Property" << propertyId << "bitStringOffset=" << existingProp->bitStringOffset 
@@ -238,7 +238,7 @@ bool PropertyModificationEngine::reconstructItemBitString(ItemInfo *item)
             // Try to accurately parse properties using ItemParser::parseItemProperties
             // Create a reader positioned at propertiesStart and attempt to parse properties.
             QString currentBitString = item->bitString;
-            ReverseBitReader reader(currentBitString);
+            ReverseBitReader reader(currentBitString, ReverseBitReader::StickyErrors);
             // set reader position to propertiesStart (pos is relative to left side)
             reader.setPos(propertiesStart);
             ItemInfo::ParsingStatus tmpStatus = ItemInfo::Ok;
@@ -595,7 +595,7 @@ void PropertyModificationEngine::writePropertyToBits(QString &bitString, int pro
 {
     if (!property) return;
     
-    ItemPropertyTxt *propTxt = ItemDataBase::Properties()->value(propertyId);
+    ItemPropertyTxt *propTxt = ItemDataBase::propertyTxt(propertyId);
     if (!propTxt) return;
     
     // Handle special properties
@@ -648,7 +648,7 @@ void PropertyModificationEngine::writeEnhancedDamageProperty(QString &bitString,
 {
     insertPropertyId(bitString, Enums::ItemProperties::EnhancedDamage);
     
-    ItemPropertyTxt *propTxt = ItemDataBase::Properties()->value(Enums::ItemProperties::EnhancedDamage);
+    ItemPropertyTxt *propTxt = ItemDataBase::propertyTxt(Enums::ItemProperties::EnhancedDamage);
     if (!propTxt) return;
     
     int adjustedValue = value + propTxt->add;
@@ -660,8 +660,8 @@ void PropertyModificationEngine::writeEnhancedDamageProperty(QString &bitString,
 
 void PropertyModificationEngine::writeElementalDamageProperty(QString &bitString, int baseId, int minValue, int maxValue, int length)
 {
-    ItemPropertyTxt *minPropTxt = ItemDataBase::Properties()->value(baseId);
-    ItemPropertyTxt *maxPropTxt = ItemDataBase::Properties()->value(baseId + 1);
+    ItemPropertyTxt *minPropTxt = ItemDataBase::propertyTxt(baseId);
+    ItemPropertyTxt *maxPropTxt = ItemDataBase::propertyTxt(baseId + 1);
     
     if (!minPropTxt || !maxPropTxt) return;
     
@@ -676,7 +676,7 @@ void PropertyModificationEngine::writeElementalDamageProperty(QString &bitString
     // Write length for cold/poison
     if (length > 0 && (baseId == Enums::ItemProperties::MinimumDamageCold || 
                        baseId == Enums::ItemProperties::MinimumDamagePoison)) {
-        ItemPropertyTxt *lengthPropTxt = ItemDataBase::Properties()->value(baseId + 2);
+        ItemPropertyTxt *lengthPropTxt = ItemDataBase::propertyTxt(baseId + 2);
         if (lengthPropTxt) {
             insertPropertyId(bitString, baseId + 2);
             appendBits(bitString, length + lengthPropTxt->add, lengthPropTxt->bits);
@@ -688,7 +688,7 @@ void PropertyModificationEngine::writeSkillProperty(QString &bitString, int prop
 {
     insertPropertyId(bitString, propertyId);
     
-    ItemPropertyTxt *propTxt = ItemDataBase::Properties()->value(propertyId);
+    ItemPropertyTxt *propTxt = ItemDataBase::propertyTxt(propertyId);
     if (!propTxt) return;
     
     // Write skill ID parameter
@@ -704,7 +704,7 @@ void PropertyModificationEngine::writeBooleanProperty(QString &bitString, int pr
 {
     insertPropertyId(bitString, propertyId);
     
-    ItemPropertyTxt *propTxt = ItemDataBase::Properties()->value(propertyId);
+    ItemPropertyTxt *propTxt = ItemDataBase::propertyTxt(propertyId);
     if (!propTxt) return;
     
     appendBits(bitString, value ? 1 : 0, propTxt->bits);
@@ -712,7 +712,7 @@ void PropertyModificationEngine::writeBooleanProperty(QString &bitString, int pr
 
 bool PropertyModificationEngine::validateProperty(int propertyId, int value, quint32 parameter, QString *error)
 {
-    ItemPropertyTxt *propTxt = ItemDataBase::Properties()->value(propertyId);
+    ItemPropertyTxt *propTxt = ItemDataBase::propertyTxt(propertyId);
     if (!propTxt) {
         if (error) *error = tr("Unknown property ID: %1").arg(propertyId);
         return false;
@@ -787,7 +787,7 @@ bool PropertyModificationEngine::validatePropertyCombination(const PropertiesMul
     // Check for duplicate properties that shouldn't be duplicated
     for (auto it = propertyCount.constBegin(); it != propertyCount.constEnd(); ++it) {
         if (it.value() > 1) {
-            ItemPropertyTxt *propTxt = ItemDataBase::Properties()->value(it.key());
+            ItemPropertyTxt *propTxt = ItemDataBase::propertyTxt(it.key());
             QString propName = propTxt ? QString::fromUtf8(propTxt->stat) : QString::number(it.key());
             
             if (error) *error = tr("Duplicate property not allowed: %1 (appears %2 times)")
@@ -847,7 +847,7 @@ bool PropertyModificationEngine::isSpecialProperty(int propertyId) const
 
 int PropertyModificationEngine::calculateBitLength(int propertyId, int value, quint32 parameter) const
 {
-    ItemPropertyTxt *propTxt = ItemDataBase::Properties()->value(propertyId);
+    ItemPropertyTxt *propTxt = ItemDataBase::propertyTxt(propertyId);
     if (!propTxt) return 0;
     
     int totalBits = 9; // Property ID
@@ -987,7 +987,7 @@ int PropertyModificationEngine::calculatePropertiesStartPosition(ItemInfo *item)
         if (offset > 16) { // Must be after JM header
             // ItemParser offset points at the start of (param+value) for the property instance
             // To find the start of the property sequence we need to back up by: paramBits + valueBits + propertyID(9)
-            ItemPropertyTxt *propTxt = ItemDataBase::Properties()->value(firstProp.key());
+            ItemPropertyTxt *propTxt = ItemDataBase::propertyTxt(firstProp.key());
             if (propTxt) {
                 int backBits = 9 + propTxt->paramBits + propTxt->bits;
                 int propertiesStart = item->bitString.length() - (offset - 16) - backBits;
@@ -1134,7 +1134,7 @@ void PropertyModificationEngine::skipItemBasicData(ReverseBitReader &bitReader,
         if (safeReadBool()) // autoprefix
             safeSkip(11);
 
-        ItemBase *itemBase = ItemDataBase::Items()->value(item->itemType);
+        ItemBase *itemBase = ItemDataBase::itemBase(item->itemCode());
         if (!itemBase) return;
         
         switch (item->quality) {
@@ -1178,18 +1178,19 @@ void PropertyModificationEngine::skipItemBasicData(ReverseBitReader &bitReader,
             safeSkip(5); // book ID
 
         // Handle armor/weapon specific data - mirror ItemParser logic exactly
-        const bool isArmor = ItemParser::itemTypesInheritFromType(itemBase->types, "armo");
+        static const int kArmorTypeId = ItemDataBase::itemTypeId("armo"), kWeaponTypeId = ItemDataBase::itemTypeId("weap");
+        const bool isArmor = ItemDataBase::itemBaseInheritsFrom(itemBase, kArmorTypeId);
         if (isArmor) {
-            ItemPropertyTxt *defenceProp = ItemDataBase::Properties()->value(Enums::ItemProperties::Defence);
+            ItemPropertyTxt *defenceProp = ItemDataBase::propertyTxt(Enums::ItemProperties::Defence);
             if (defenceProp) safeReadNumber(defenceProp->bits); // Read defense but don't store
         }
-        if (isArmor || ItemParser::itemTypesInheritFromType(itemBase->types, "weap")) {
-            ItemPropertyTxt *maxDurabilityProp = ItemDataBase::Properties()->value(Enums::ItemProperties::DurabilityMax);
+        if (isArmor || ItemDataBase::itemBaseInheritsFrom(itemBase, kWeaponTypeId)) {
+            ItemPropertyTxt *maxDurabilityProp = ItemDataBase::propertyTxt(Enums::ItemProperties::DurabilityMax);
             if (maxDurabilityProp) {
                 // Read maxDurability to check if we need to read current durability too
                 int maxDurability = safeReadNumber(maxDurabilityProp->bits) - maxDurabilityProp->add;
                 if (maxDurability > 0) {
-                    ItemPropertyTxt *durabilityProp = ItemDataBase::Properties()->value(Enums::ItemProperties::Durability);
+                    ItemPropertyTxt *durabilityProp = ItemDataBase::propertyTxt(Enums::ItemProperties::Durability);
                     if (durabilityProp) safeReadNumber(durabilityProp->bits); // Read current durability but don't store
                 }
             }
@@ -1735,7 +1736,7 @@ bool PropertyModificationEngine::tryPropertyReplacement(ItemInfo *item, int newP
     // Strategy: Find a property with similar bit requirements and replace it
     // This maintains the same total bitString length
     
-    ItemPropertyTxt *newPropTxt = ItemDataBase::Properties()->value(newPropertyId);
+    ItemPropertyTxt *newPropTxt = ItemDataBase::propertyTxt(newPropertyId);
     if (!newPropTxt) {
         qDebug() << "Option F: FAILED - Unknown property ID" << newPropertyId;
         return false;
@@ -1752,7 +1753,7 @@ bool PropertyModificationEngine::tryPropertyReplacement(ItemInfo *item, int newP
         int existingId = it.key();
         if (existingId == newPropertyId) continue; // Don't replace with itself
         
-        ItemPropertyTxt *existingPropTxt = ItemDataBase::Properties()->value(existingId);
+        ItemPropertyTxt *existingPropTxt = ItemDataBase::propertyTxt(existingId);
         if (!existingPropTxt) continue;
         
         int existingBits = 9 + existingPropTxt->paramBits + existingPropTxt->bits;
@@ -1813,7 +1814,7 @@ bool PropertyModificationEngine::tryPropertyReplacement(ItemInfo *item, int newP
         
         // Find afterProperties by parsing the original properties
         QString afterProperties;
-        ReverseBitReader reader(originalBitString);
+        ReverseBitReader reader(originalBitString, ReverseBitReader::StickyErrors);
         reader.setPos(propertiesStart);
         ItemInfo::ParsingStatus status = ItemInfo::Ok;
         PropertiesMultiMap parsedProps = ItemParser::parseItemProperties(reader, &status);
@@ -7,8 +7,10 @@
 class ResourcePathManager
 {
 public:
-    static QString dataPathForFileName(const QString &fileName) { return QString("%1/data/%2").arg(LanguageManager::instance().resourcesPath).arg(fileName); }
-    static QString localizedPathForFileName(const QString &fileName) { return dataPathForFileName(QString("%1/%2.dat").arg(LanguageManager::instance().modLocalization()).arg(fileName)); }
+    static QString dataPath() { return QString("%1/data").arg(LanguageManager::instance().resourcesPath); }
+    static QString dataPathForFileName(const QString &fileName) { return QString("%1/%2").arg(dataPath()).arg(fileName); }
+    static QString localizedFileName(const QString &fileName) { return QString("%1/%2.dat").arg(LanguageManager::instance().modLocalization()).arg(fileName); }
+    static QString localizedPathForFileName(const QString &fileName) { return dataPathForFileName(localizedFileName(fileName)); }
     static QString pathForSortOrderFileName(const QString &fileName) { return dataPathForFileName(QString("sorting/%1.txt").arg(fileName)); }
 
     static QString pathForImagePath(const QString &imagePath) { return dataPathForFileName(QString("images/%1").arg(imagePath)); }
@@ -3,13 +3,24 @@
 
 qint64 ReverseBitReader::readNumber(int length, bool *ok /*= 0*/)
 {
+    if (_error)
+    {
+        if (ok)
+            *ok = false;
+        return 0;
+    }
+
     if (_pos - length >= 0)
     {
         if (ok)
             *ok = true;
 
+        int startPos = pos();
         _pos -= length;
-        return _bitString.mid(_pos, length).toLongLong(ok, 2);
+        if (length <= 0)
+            return 0;
+        length = qMin(length, ItemBitBuffer::kBitsInWord);
+        return static_cast<qint64>(_data ? ItemBitBuffer::bitsFromBytes(_data, startPos, length) : _bits.bits(startPos, length));
     }
     else
     {
@@ -17,34 +28,47 @@ qint64 ReverseBitReader::readNumber(int length, bool *ok /*= 0*/)
             *ok = false;
 
         qWarning("attempt to read past bitstring length");
-        _pos = _bitString.length() + 1;
-        throw 1;
+        _pos = _size + 1;
+        setError(1);
         return 0;
     }
 }
 
 int ReverseBitReader::setPos(int newPos)
 {
-    if (newPos >= 0 && newPos < _bitString.length())
+    if (_error)
+        return -1;
+
+    if (newPos >= 0 && newPos < _size)
     {
-        _pos = _bitString.length() - newPos;
+        _pos = _size - newPos;
         return _pos;
     }
     else
     {
         qWarning("attempt to set new position past bitstring length");
-        throw 2;
+        setError(2);
         return -1;
     }
 }
 
 void ReverseBitReader::skip(int length)
 {
-    if (_pos - length > 0 && _pos - length <= _bitString.length())
+    if (_error)
+        return;
+
+    if (_pos - length > 0 && _pos - length <= _size)
         _pos -= length;
     else
     {
         qWarning("attempt to skip past bitstring length");
-        throw 3;
+        setError(3);
     }
 }
+
+void ReverseBitReader::setError(int errorCode)
+{
+    if (_errorMode == ThrowErrors)
+        throw errorCode;
+    _error = errorCode;
+}
@@ -1,29 +1,50 @@
 #ifndef REVERSEBITREADER_H
 #define REVERSEBITREADER_H
 
-#include <QString>
+#include "itembitbuffer.h"
 
 
+// reads item bits starting from bit 0 (LSB of the first byte), up to 64 bits per read
+// by default errors are thrown as int codes (1 - read, 2 - setPos, 3 - skip),
+// in StickyErrors mode the first error code is kept in error() and all later reads return 0 and skips do nothing
 class ReverseBitReader
 {
 public:
-    ReverseBitReader(const QString &bitString) : _bitString(bitString), _pos(bitString.length()) {}
+    enum ErrorMode
+    {
+        ThrowErrors,
+        StickyErrors
+    };
+
+    ReverseBitReader(const QString &bitString, ErrorMode errorMode = ThrowErrors) : _bits(bitString), _data(0), _size(_bits.size()), _pos(_size), _errorMode(errorMode), _error(0) {}
+    ReverseBitReader(const ItemBitBuffer &bits, ErrorMode errorMode = ThrowErrors) : _bits(bits), _data(0), _size(bits.size()), _pos(_size), _errorMode(errorMode), _error(0) {}
+    // reads straight from bytes that must outlive the reader, notReadBits() and at() aren't available
+    ReverseBitReader(const char *data, int bytesCount, ErrorMode errorMode = ThrowErrors) : _data(data), _size(bytesCount * 8), _pos(_size), _errorMode(errorMode), _error(0) {}
 
     inline bool readBool(bool *ok = 0) { return static_cast<bool>(readNumber(1, ok)); }
     qint64 readNumber(int length, bool *ok = 0);
 
-    int pos() const { return _bitString.length() - _pos; }
+    int pos() const { return _size - _pos; }
     int absolutePos() const { return _pos; }
 
     int setPos(int newPos);
     void skip(int length = 1);
 
-    QString notReadBits() const { return _bitString.left(_pos); }
-    QChar at(int pos) const { return _bitString.at(_bitString.length() - pos); }
+    int error() const { return _error; }
+    bool hasError() const { return _error != 0; }
+
+    QString notReadBits() const { return _bits.left(_pos); }
+    QChar at(int pos) const { return _bits.at(_size - pos); }
 
 private:
-    QString _bitString;
-    int _pos;
+    ItemBitBuffer _bits;
+    const char *_data;
+    int _size;
+    int _pos; // number of bits left to read, kept for the old string-based positions
+    ErrorMode _errorMode;
+    int _error;
+
+    void setError(int errorCode);
 };
 
 #endif // REVERSEBITREADER_H
@@ -12,26 +12,58 @@ QString &ReverseBitWriter::replaceValueInBitString(QString &bitString, int offse
     return bitString.replace(startOffset(bitString, offset, length), length, binaryStringFromNumber(newValue, false, length));
 }
 
-QString &ReverseBitWriter::updateItemRow(ItemInfo *item)
+ItemBitBuffer &ReverseBitWriter::replaceValueInBitString(ItemBitBuffer &bits, int offset, int newValue, int length /*= -1*/)
+{
+    if (length == -1)
+        length = Enums::ItemOffsets::offsetLength(offset);
+    if (length > 0)
+        bits.setBits(offset - 16, length, static_cast<quint64>(newValue)); // 16 is 'JM' offset
+    return bits;
+}
+
+ItemBitBuffer &ReverseBitWriter::updateItemRow(ItemInfo *item)
 {
     return replaceValueInBitString(item->bitString, Enums::ItemOffsets::Row, item->row);
 }
 
-QString &ReverseBitWriter::updateItemColumn(ItemInfo *item)
+ItemBitBuffer &ReverseBitWriter::updateItemColumn(ItemInfo *item)
 {
     return replaceValueInBitString(item->bitString, Enums::ItemOffsets::Column, item->column);
 }
 
+ItemBitBuffer &ReverseBitWriter::updateItemPosition(ItemInfo *item)
+{
+    // row bits follow column bits
+    const int kColumnLength = Enums::ItemOffsets::offsetLength(Enums::ItemOffsets::Column), kRowLength = Enums::ItemOffsets::offsetLength(Enums::ItemOffsets::Row);
+    quint64 value = (static_cast<quint64>(item->column) & ((1 << kColumnLength) - 1)) | (static_cast<quint64>(item->row) & ((1 << kRowLength) - 1)) << kColumnLength;
+    item->bitString.setBits(Enums::ItemOffsets::Column - 16, kColumnLength + kRowLength, value); // 16 is 'JM' offset
+    return item->bitString;
+}
+
 QString &ReverseBitWriter::remove(QString &bitString, int offsetWithoutJM, int length)
 {
     return bitString.remove(startOffset(bitString, offsetWithoutJM, length, false) - 1, length);
 }
 
+// inserts and removes are applied to the bits in one pass on the next read or before the item is written
+ItemBitBuffer &ReverseBitWriter::remove(ItemBitBuffer &bits, int offsetWithoutJM, int length)
+{
+    // same bits as the string version removes: it starts one bit above the offset
+    bits.remove(offsetWithoutJM + 1, length);
+    return bits;
+}
+
 QString &ReverseBitWriter::insert(QString &bitString, int offsetWithoutJM, const QString &bitStringToInsert)
 {
     return bitString.insert(startOffset(bitString, offsetWithoutJM, 0, false), bitStringToInsert);
 }
 
+ItemBitBuffer &ReverseBitWriter::insert(ItemBitBuffer &bits, int offsetWithoutJM, const QString &bitStringToInsert)
+{
+    bits.insert(offsetWithoutJM, ItemBitBuffer(bitStringToInsert));
+    return bits;
+}
+
 QString &ReverseBitWriter::byteAlignBits(QString &bitString)
 {
     // Safer byte alignment: append zeros at the END of the bit string to make
@@ -48,6 +80,19 @@ QString &ReverseBitWriter::byteAlignBits(QString &bitString)
     return bitString;
 }
 
+ItemBitBuffer &ReverseBitWriter::byteAlignBits(ItemBitBuffer &bits)
+{
+    // zeros go where the string version appends them: the end of the string is bit 0
+    const int kBitsInByte = 8;
+    if (int extraBits = bits.size() % kBitsInByte)
+    {
+        ItemBitBuffer zeros;
+        zeros.resize(kBitsInByte - extraBits);
+        bits.insert(0, zeros);
+    }
+    return bits;
+}
+
 
 int ReverseBitWriter::startOffset(const QString &bitString, int offset, int length, bool isItemHeaderSkipped/* = true*/)
 {
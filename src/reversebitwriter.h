@@ -4,17 +4,23 @@
 
 class QString;
 class ItemInfo;
+class ItemBitBuffer;
 
 class ReverseBitWriter
 {
 public:
     static QString &replaceValueInBitString(QString &bitString, int offset, int newValue, int length = -1);
-    static QString &updateItemRow(ItemInfo *item);
-    static QString &updateItemColumn(ItemInfo *item);
+    static ItemBitBuffer &replaceValueInBitString(ItemBitBuffer &bits, int offset, int newValue, int length = -1);
+    static ItemBitBuffer &updateItemRow(ItemInfo *item);
+    static ItemBitBuffer &updateItemColumn(ItemInfo *item);
+    static ItemBitBuffer &updateItemPosition(ItemInfo *item); // column and row in one write
 
     static QString &remove(QString &bitString, int offset, int length);
+    static ItemBitBuffer &remove(ItemBitBuffer &bits, int offsetWithoutJM, int length);
     static QString &insert(QString &bitString, int offsetWithoutJM, const QString &bitStringToInsert);
+    static ItemBitBuffer &insert(ItemBitBuffer &bits, int offsetWithoutJM, const QString &bitStringToInsert);
     static QString &byteAlignBits(QString &bitString);
+    static ItemBitBuffer &byteAlignBits(ItemBitBuffer &bits);
 
 private:
     static int startOffset(const QString &bitString, int offsetWithoutJM, int length, bool isItemHeaderSkipped = true);
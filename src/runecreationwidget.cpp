@@ -336,7 +336,7 @@ ItemInfo* RuneCreationWidget::createRuneItem(const QString &runeCode)
         // Update itemType to match selected rune if different
         if (rune->itemType != runeCode.toUtf8()) {
             qDebug() << "Updating itemType from" << rune->itemType << "to" << runeCode;
-            rune->itemType = runeCode.toUtf8();
+            rune->setItemType(runeCode.toUtf8());
             
             // Update itemType in bitString
             for (int i = 0; i < rune->itemType.length() && i < 4; i++) {
@@ -0,0 +1,257 @@
+#include "savetransaction.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+
+#if IS_QT5
+#include <QStandardPaths>
+#include <QtConcurrent/QtConcurrentMap>
+#else
+#include <QDesktopServices>
+#include <QtConcurrentMap>
+#endif
+
+#ifdef Q_OS_WIN32
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+
+// QFile::flush() only empties Qt's buffer, the data must be on disk before the old file is replaced
+static bool syncToDisk(QFile &file)
+{
+    if (!file.flush())
+        return false;
+
+    int fd = file.handle();
+#ifdef Q_OS_WIN32
+    return fd == -1 || !_commit(fd);
+#else
+    return fd == -1 || !fsync(fd);
+#endif
+}
+
+// a rename is on disk only after its directory is flushed, NTFS doesn't need this
+static void syncDirectory(const QString &path)
+{
+#ifdef Q_OS_WIN32
+    Q_UNUSED(path);
+#else
+    int fd = open(QFile::encodeName(path).constData(), O_RDONLY);
+    if (fd != -1)
+    {
+        fsync(fd);
+        close(fd);
+    }
+#endif
+}
+
+void SaveTransaction::addFile(const QString &path, const QByteArray &bytes)
+{
+    File file;
+    file.path = path;
+    file.bytes = bytes;
+    file.isMovedAside = file.isReplaced = false;
+    _files += file;
+}
+
+bool SaveTransaction::commit()
+{
+    _errorFileName.clear();
+    _errorString.clear();
+
+    // the temporary files of an unfinished save have the same names, so it must be finished first
+    SaveTransaction interruptedSave;
+    if (!interruptedSave.recover())
+    {
+        _files.clear();
+        return setError(interruptedSave.errorFileName(), interruptedSave.errorString());
+    }
+
+    QtConcurrent::blockingMap(_files, writeTempFile);
+    foreach (const File &file, _files)
+        if (!file.error.isEmpty())
+            return fail(file.path, file.error);
+
+    if (!writeJournal())
+        return false;
+
+    for (int i = 0; i < _files.size(); ++i)
+        if (!replace(_files[i]))
+            return fail(_files.at(i).path, _files.at(i).error);
+
+    finish();
+    return true;
+}
+
+bool SaveTransaction::recover()
+{
+    _errorFileName.clear();
+    _errorString.clear();
+
+    QString path = journalPath();
+    if (path.isEmpty())
+        return true;
+    QFile::remove(tempPath(path)); // the journal wasn't finished, so no target was touched
+
+    QFile journal(path);
+    if (!journal.exists())
+        return true;
+    if (!journal.open(QIODevice::ReadOnly))
+        return setError(path, journal.errorString());
+
+    foreach (const QByteArray &line, journal.readAll().split('\n'))
+        if (!line.isEmpty())
+            addFile(QString::fromUtf8(line), QByteArray());
+    journal.close();
+
+    // every new file is complete once the journal exists, so the files that weren't replaced yet are replaced now
+    for (int i = 0; i < _files.size(); ++i)
+    {
+        File &file = _files[i];
+        if (!replace(file))
+        {
+            setError(file.path, file.error);
+            _files.clear(); // the journal is kept, it's tried again next time
+            return false;
+        }
+    }
+
+    finish();
+    return true;
+}
+
+QString SaveTransaction::journalPath()
+{
+#if IS_QT5
+    QString dataPath = QStandardPaths::writableLocation(QStandardPaths::DataLocation);
+#else
+    QString dataPath = QDesktopServices::storageLocation(QDesktopServices::DataLocation);
+#endif
+    return dataPath.isEmpty() ? QString() : dataPath + "/save.journal";
+}
+
+void SaveTransaction::writeTempFile(File &file)
+{
+    QFile tempFile(tempPath(file.path));
+    if (!tempFile.open(QIODevice::WriteOnly) || tempFile.write(file.bytes) != file.bytes.size() || !syncToDisk(tempFile))
+        file.error = tempFile.errorString();
+}
+
+bool SaveTransaction::writeJournal()
+{
+    QString path = journalPath();
+    if (path.isEmpty())
+    {
+        qWarning("no data directory for the save journal, a crash while saving can't be rolled forward");
+        return true;
+    }
+
+    QString dirPath = QFileInfo(path).absolutePath();
+    QDir().mkpath(dirPath);
+
+    QByteArray bytes;
+    foreach (const File &file, _files)
+        bytes += file.path.toUtf8() + '\n';
+
+    // written under a temporary name too, so a journal is either complete or absent
+    QFile journal(tempPath(path));
+    if (!journal.open(QIODevice::WriteOnly) || journal.write(bytes) != bytes.size() || !syncToDisk(journal))
+    {
+        QString error = journal.errorString();
+        journal.remove();
+        return fail(path, error);
+    }
+    journal.close();
+    if (!journal.rename(path))
+    {
+        QString error = journal.errorString();
+        journal.remove();
+        return fail(path, error);
+    }
+    syncDirectory(dirPath);
+    _isJournalWritten = true;
+    return true;
+}
+
+bool SaveTransaction::replace(File &file)
+{
+    QFile newFile(tempPath(file.path));
+    if (!newFile.exists())
+        return true; // replaced before the crash
+
+    if (QFile::exists(file.path))
+    {
+        // the target is still the old file here, so a copy left aside by an earlier save is stale
+        QFile::remove(oldPath(file.path));
+
+        QFile oldFile(file.path);
+        if (!oldFile.rename(oldPath(file.path)))
+        {
+            file.error = oldFile.errorString();
+            return false;
+        }
+        file.isMovedAside = true;
+    }
+
+    if (!newFile.rename(file.path))
+    {
+        file.error = newFile.errorString();
+        return false;
+    }
+    file.isReplaced = true;
+    syncDirectory(QFileInfo(file.path).absolutePath());
+    return true;
+}
+
+void SaveTransaction::finish()
+{
+    // without the journal the files left aside are only copies of what was replaced
+    QFile::remove(journalPath());
+    foreach (const File &file, _files)
+        if (QFile::exists(file.path))
+            QFile::remove(oldPath(file.path));
+    _files.clear();
+}
+
+bool SaveTransaction::setError(const QString &fileName, const QString &error)
+{
+    _errorFileName = fileName;
+    _errorString = error;
+    return false;
+}
+
+bool SaveTransaction::fail(const QString &fileName, const QString &error)
+{
+    setError(fileName, error);
+    rollback();
+    return false;
+}
+
+void SaveTransaction::rollback()
+{
+    // new files go back to the temporary names while the journal exists, so a crash here is still rolled forward
+    bool isUndone = true;
+    for (int i = _files.size() - 1; i >= 0; --i)
+    {
+        const File &file = _files.at(i);
+        if (file.isReplaced && !QFile::rename(file.path, tempPath(file.path)))
+            isUndone = false;
+        else if (file.isMovedAside && !QFile::rename(oldPath(file.path), file.path))
+            isUndone = false;
+    }
+
+    // if a file couldn't be put back, the journal stays and the save is finished by recover() instead
+    if (isUndone)
+    {
+        if (_isJournalWritten)
+            QFile::remove(journalPath());
+        foreach (const File &file, _files)
+            QFile::remove(tempPath(file.path));
+    }
+    _files.clear();
+    _isJournalWritten = false;
+}
@@ -0,0 +1,53 @@
+#ifndef SAVETRANSACTION_H
+#define SAVETRANSACTION_H
+
+#include <QList>
+#include <QString>
+#include <QByteArray>
+
+
+// Replaces several files so that either all of them get the new contents or none does.
+// commit() writes every file to a temporary one next to it in parallel and flushes them to disk, then writes a journal
+// listing the targets, after that the targets are moved aside and the temporary files are renamed in their place one after another.
+// Once the journal exists the new contents are complete, so a save interrupted by a crash is rolled forward by recover(),
+// and a failed rename is undone by moving the new files back to the temporary names before the journal is removed.
+class SaveTransaction
+{
+public:
+    SaveTransaction() : _isJournalWritten(false) {}
+
+    void addFile(const QString &path, const QByteArray &bytes);
+    bool isEmpty() const { return _files.isEmpty(); }
+
+    bool commit(); // false if a file couldn't be written or replaced, all files are as they were then unless even the undo failed
+    bool recover(); // finishes a save left by a crash or a failed undo, is called on startup and by commit()
+    QString errorFileName() const { return _errorFileName; }
+    QString errorString() const { return _errorString; }
+
+private:
+    struct File
+    {
+        QString path;
+        QByteArray bytes;
+        QString error;
+        bool isMovedAside, isReplaced;
+    };
+
+    QList<File> _files;
+    QString _errorFileName, _errorString;
+    bool _isJournalWritten;
+
+    static QString tempPath(const QString &path) { return path + ".saving"; }
+    static QString oldPath(const QString &path) { return path + ".replaced"; }
+    static QString journalPath();
+    static void writeTempFile(File &file);
+
+    bool writeJournal();
+    static bool replace(File &file);
+    void finish();
+    bool setError(const QString &fileName, const QString &error);
+    bool fail(const QString &fileName, const QString &error);
+    void rollback();
+};
+
+#endif // SAVETRANSACTION_H
@@ -31,7 +31,7 @@ SpecialItemCreationWidget::SpecialItemCreationWidget(QWidget *parent)
         };
 
         for (const QString &code : oilCodes) {
-            ItemBase *b = ItemDataBase::Items()->value(code.toUtf8());
+            ItemBase *b = ItemDataBase::itemBase(code.toUtf8());
             QString label = b ? QString("%1 - %2").arg(b->name).arg(code) : QString("%1").arg(code);
             QListWidgetItem *it = new QListWidgetItem(label);
             it->setData(Qt::UserRole, code);
@@ -105,7 +105,7 @@ void SpecialItemCreationWidget::onSelectionChanged()
     QListWidgetItem *it = _list->currentItem();
     if (!it) { _previewLabel->setText(tr("No base selected.")); return; }
     QString code = it->data(Qt::UserRole).toString();
-    ItemBase *b = ItemDataBase::Items()->value(code.toUtf8());
+    ItemBase *b = ItemDataBase::itemBase(code.toUtf8());
     QString txt = QString("<b>%1</b><br>Code: %2<br>Size: %3x%4<br>Req Lvl: %5")
             .arg(b ? b->name : QString("<unknown>"))
             .arg(code)
@@ -164,7 +164,7 @@ void SpecialItemCreationWidget::onCreateClicked()
         item->hasChanged = true;
 
         // Keep itemType field consistent with the modified bitString
-        item->itemType = code.toUtf8();
+        item->setItemType(code.toUtf8());
 
         // Optionally attach a simple property if provided
         int propId = _propIdSpin->value();
@@ -186,9 +186,9 @@ void SpecialItemCreationWidget::onCreateClicked()
     } else {
         // Minimal construction
         item = new ItemInfo();
-        item->itemType = code.toUtf8();
+        item->setItemType(code.toUtf8());
         item->isExtended = true;
-        ItemBase *base = ItemDataBase::Items()->value(code.toUtf8());
+        ItemBase *base = ItemDataBase::itemBase(code.toUtf8());
         if (base) item->ilvl = base->rlvl;
         item->quality = Enums::ItemQuality::Unique;
     }
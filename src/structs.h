@@ -3,6 +3,12 @@
 
 #include "enums.h"
 #include "reversebitwriter.h"
+#include "itembitbuffer.h"
+#include "itemcodetable.h"
+
+#include <QBitArray>
+#include <QSharedData>
+#include <QSharedPointer>
 
 
 // internal
@@ -21,38 +27,127 @@ struct ItemProperty
 typedef QMultiMap<int, ItemProperty *> PropertiesMultiMap;
 typedef QMap<int, ItemProperty *> PropertiesMap;
 
+// property lists of a loaded item that weren't decoded yet, shared by ItemInfo::props and ItemInfo::rwProps
+struct LazyPropertyLists
+{
+    ItemBitBuffer bits; // item bits at load time
+    int offset;         // position of the item properties list
+    QByteArray itemType;
+    int setListsNumber;
+    bool isRW, isDecoded;
+    PropertiesMultiMap props, rwProps;
+
+    LazyPropertyLists() : offset(0), setListsNumber(0), isRW(false), isDecoded(false) {}
+    void decode(); // ItemParser::decodePropertyLists()
+};
+
+// PropertiesMultiMap that's decoded from LazyPropertyLists on first access
+class LazyPropertiesMultiMap
+{
+public:
+    typedef PropertiesMultiMap::iterator iterator;
+    typedef PropertiesMultiMap::const_iterator const_iterator;
+
+    enum List
+    {
+        ItemList,
+        RunewordList
+    };
+
+    LazyPropertiesMultiMap() : _list(ItemList) {}
+    LazyPropertiesMultiMap(const PropertiesMultiMap &props) : _props(props), _list(ItemList) {}
+    LazyPropertiesMultiMap &operator=(const PropertiesMultiMap &props) { _source.clear(); _props = props; return *this; }
+
+    void setSource(const QSharedPointer<LazyPropertyLists> &source, List list) { _source = source; _list = list; _props.clear(); }
+    const QSharedPointer<LazyPropertyLists> &source() const { return _source; }
+    bool isDecoded() const { return !_source; }
+    void deleteProperties() { if (_source && !_source->isDecoded) _source.clear(); else qDeleteAll(map()); } // doesn't decode just to delete
+
+    PropertiesMultiMap &map() { decode(); return _props; }
+    const PropertiesMultiMap &map() const { decode(); return _props; }
+    operator PropertiesMultiMap &() { return map(); }
+    operator const PropertiesMultiMap &() const { return map(); }
+
+    iterator begin() { return map().begin(); }
+    iterator end() { return map().end(); }
+    const_iterator begin() const { return map().constBegin(); }
+    const_iterator end() const { return map().constEnd(); }
+    const_iterator constBegin() const { return map().constBegin(); }
+    const_iterator constEnd() const { return map().constEnd(); }
+    iterator find(int key) { return map().find(key); }
+    const_iterator find(int key) const { return map().constFind(key); }
+    const_iterator constFind(int key) const { return map().constFind(key); }
+    QPair<iterator, iterator> equal_range(int key) { return map().equal_range(key); }
+
+    iterator insert(int key, ItemProperty *prop) { return map().insert(key, prop); }
+    iterator replace(int key, ItemProperty *prop) { return map().replace(key, prop); }
+    int remove(int key) { return map().remove(key); }
+    void clear() { _source.clear(); _props.clear(); }
+
+    int size() const { return map().size(); }
+    bool isEmpty() const { return map().isEmpty(); }
+    bool contains(int key) const { return map().contains(key); }
+    ItemProperty *value(int key) const { return map().value(key); }
+    QList<int> keys() const { return map().keys(); }
+    QList<ItemProperty *> values(int key) const { return map().values(key); }
+
+private:
+    mutable PropertiesMultiMap _props;
+    mutable QSharedPointer<LazyPropertyLists> _source;
+    List _list;
+
+    void decode() const
+    {
+        if (!_source)
+            return;
+        if (!_source->isDecoded)
+            _source->decode();
+        _props = _list == ItemList ? _source->props : _source->rwProps;
+        _source.clear();
+    }
+};
+
 
 class ItemInfo;
 typedef QList<ItemInfo *> ItemsList;
 
-class ItemInfo
+// fields only ears, personalized items and runewords have: they're allocated just for such items
+// and shared between copies of an item until one of the copies changes them
+struct ItemRareInfo : public QSharedData
 {
-public:
-    bool isQuest, isIdentified, isSocketed, isEar, isStarter, isExtended, isEthereal, isPersonalized, isRW;
-    int location, whereEquipped, row, column, storage;
     struct
     {
         quint8 classCode, level;
         QByteArray name;
-    } earInfo; // isEar == true
-    QByteArray itemType; // key to get ItemBase
+    } earInfo;                // isEar == true
+    QByteArray inscribedName; // isPersonalized == true
+    QString rwName;           // isRW == true
+
+    ItemRareInfo() { earInfo.classCode = earInfo.level = 0; }
+};
+
+class ItemInfo
+{
+public:
+    bool isQuest, isIdentified, isSocketed, isEar, isStarter, isExtended, isEthereal, isPersonalized, isRW;
+    int location, whereEquipped, row, column, storage;
+    QByteArray itemType; // key to get ItemBase, is changed only through setItemType() to keep itemCode() in sync
     // fields below exist if isExtended == true
     quint32 guid;
     quint8 socketablesNumber, ilvl, quality, variableGraphicIndex;
     int nonMagicType;                     // quality == 1 || quality == 3 (low quality or superior)
     int setOrUniqueId;                    // key to get SetItemInfo or UniqueItemInfo
-    QByteArray inscribedName;             // isPersonalized == true
     int defense;                          // itemBase.genericType == Enums::ItemType::Armor
     int currentDurability, maxDurability; // itemBase.genericType != Enums::ItemTypeGeneric::Misc
     int quantity;                         // itemBase.isStackable == true
     qint8 socketsNumber;                  // isSocketed == true
-    PropertiesMultiMap props, rwProps;//, setProps;
+    LazyPropertiesMultiMap props, rwProps;//, setProps; decoded on first access when ItemParser::isLazyPropertiesDecoding()
     ItemsList socketablesInfo;            // 0 <= size <= 6
-    QString rwName;                       // isRW == true
 
     quint32 plugyPage;
     bool hasChanged;
-    QString bitString;
+    ItemBitBuffer bitString; // packed item bits without 'JM', still readable as the old '0'/'1' string
+    int fileOffset, fileBytesCount; // 'JM' of the item and the bytes up to the end of its socketables in the file it was read from, offset is -1 for created items
 
     enum ParsingStatus
     {
@@ -66,7 +161,14 @@ public:
 
     ItemInfo() { init(); }
     ItemInfo(const QString &bits) : bitString(bits) { init(); }
-    ~ItemInfo() { if (shouldDeleteEverything) { qDeleteAll(props); qDeleteAll(rwProps); qDeleteAll(socketablesInfo); } }
+    ItemInfo(const ItemBitBuffer &bits) : bitString(bits) { init(); }
+    ~ItemInfo() { if (shouldDeleteEverything) { props.deleteProperties(); rwProps.deleteProperties(); qDeleteAll(socketablesInfo); } }
+
+    ItemCode itemCode() const { return _itemCode; } // itemType packed when it's set
+    void setItemType(const QByteArray &type) { itemType = type; _itemCode = itemCodeFromType(type); }
+
+    ItemRareInfo rareInfo() const { return _rareInfo ? *_rareInfo : ItemRareInfo(); } // ear info, inscribed name and RW name
+    ItemRareInfo &rareInfoForWrite() { if (!_rareInfo) _rareInfo = new ItemRareInfo; return *_rareInfo; }
 
     void move(int newRow, int newCol, quint32 newPage, bool shouldChangeBits = true)
     {
@@ -77,13 +179,15 @@ public:
         if (shouldChangeBits)
         {
             hasChanged = true;
-            ReverseBitWriter::updateItemRow(this);
-            ReverseBitWriter::updateItemColumn(this);
+            ReverseBitWriter::updateItemPosition(this);
         }
     }
 
 private:
-    void init() { plugyPage = 0; hasChanged = false; ilvl = 1; variableGraphicIndex = 0; location = row = column = storage = -1; whereEquipped = 0; shouldDeleteEverything = true; }
+    QSharedDataPointer<ItemRareInfo> _rareInfo;
+    ItemCode _itemCode;
+
+    void init() { plugyPage = 0; hasChanged = false; fileOffset = -1; fileBytesCount = 0; ilvl = 1; variableGraphicIndex = 0; location = row = column = storage = -1; whereEquipped = 0; shouldDeleteEverything = true; _itemCode = 0; }
 };
 
 
@@ -94,6 +198,7 @@ struct PlugyStashInfo
     bool exists;
     quint32 version;
     quint32 activePage;
+    QByteArray fileContents; // items read from the file share these bytes, so unchanged ones are copied back on save
 };
 
 
@@ -172,6 +277,7 @@ struct ItemBase
     quint8 questId; // non-zero value means that it's a quest item
     quint8 strBonus, dexBonus;
     QList<QByteArray> types;
+    QBitArray typesClosure; // ids of the types and everything they inherit from, see ItemDataBase::itemTypeId()
     qint8 socketableType, classCode;
 };
 
@@ -0,0 +1,186 @@
+#include "tblstringtable.h"
+
+#include <QSet>
+
+#include <algorithm>
+#include <cstring>
+
+
+const quint32 TblStringTable::kNotFound = 0xFFFFFFFF;
+
+static const quint32 kMaxSeed = 1 << 24;
+
+void TblStringTable::append(quint32 index, const QString &key, const QString &value)
+{
+    Entry entry = { static_cast<quint32>(_blob.size()), static_cast<quint32>(key.size()), static_cast<quint32>(_blob.size() + key.size()), static_cast<quint32>(value.size()) };
+    _blob += key;
+    _blob += value;
+
+    if (_ranges.isEmpty() || _ranges.last().firstIndex + _ranges.last().count != index)
+    {
+        Range range = { index, _entries.size(), 0 };
+        _ranges += range;
+    }
+    ++_ranges.last().count;
+    _entries += entry;
+    _isHashBuilt = false;
+}
+
+// hash-and-displace: keys are split into buckets by the upper half of their hash, then every bucket, largest first,
+// gets the first seed that puts all its keys into free slots
+void TblStringTable::buildHash()
+{
+    _bucketSeeds.clear();
+    _slotEntries.clear();
+    _isHashBuilt = false;
+
+    QVector<int> keyEntries;
+    QSet<QString> keys;
+    for (int i = _entries.size() - 1; i >= 0; --i)
+    {
+        QString key = QString::fromRawData(_blob.constData() + _entries.at(i).keyOffset, _entries.at(i).keyLength);
+        if (!keys.contains(key))
+        {
+            keys.insert(QString(key.constData(), key.size()));
+            keyEntries += i;
+        }
+    }
+    if (keyEntries.isEmpty())
+        return;
+
+    int keysCount = keyEntries.size(), bucketsCount = keysCount / 4 + 1;
+    QVector<quint64> hashes(keysCount);
+    QVector<QVector<int> > buckets(bucketsCount);
+    for (int i = 0; i < keysCount; ++i)
+    {
+        const Entry &entry = _entries.at(keyEntries.at(i));
+        hashes[i] = hashOf(_blob.constData() + entry.keyOffset, entry.keyLength);
+        buckets[(hashes.at(i) >> 32) % bucketsCount] += i;
+    }
+
+    QVector<QPair<int, int> > bucketsBySize; // (-size, bucket) to sort the largest first
+    bucketsBySize.reserve(bucketsCount);
+    for (int i = 0; i < bucketsCount; ++i)
+        if (!buckets.at(i).isEmpty())
+            bucketsBySize += qMakePair(-buckets.at(i).size(), i);
+    std::sort(bucketsBySize.begin(), bucketsBySize.end());
+
+    _bucketSeeds.fill(0, bucketsCount);
+    _slotEntries.fill(-1, keysCount);
+    QVector<int> bucketSlots;
+    for (int i = 0; i < bucketsBySize.size(); ++i)
+    {
+        const QVector<int> &bucket = buckets.at(bucketsBySize.at(i).second);
+        quint32 seed = 1;
+        for (; seed < kMaxSeed; ++seed)
+        {
+            bucketSlots.clear();
+            foreach (int key, bucket)
+            {
+                int slot = slotOf(hashes.at(key), seed, keysCount);
+                if (_slotEntries.at(slot) != -1 || bucketSlots.contains(slot))
+                    break;
+                bucketSlots += slot;
+            }
+            if (bucketSlots.size() == bucket.size())
+                break;
+        }
+        if (seed == kMaxSeed)
+        {
+            qWarning("no perfect hash found for %d string table keys, lookups will be linear", keysCount);
+            _bucketSeeds.clear();
+            _slotEntries.clear();
+            return;
+        }
+
+        _bucketSeeds[bucketsBySize.at(i).second] = seed;
+        for (int j = 0; j < bucket.size(); ++j)
+            _slotEntries[bucketSlots.at(j)] = keyEntries.at(bucket.at(j));
+    }
+    _isHashBuilt = true;
+}
+
+QString TblStringTable::value(quint32 index, const QString &defaultValue /*= QString()*/) const
+{
+    foreach (const Range &range, _ranges)
+    {
+        if (index >= range.firstIndex && index - range.firstIndex < static_cast<quint32>(range.count))
+        {
+            const Entry &entry = _entries.at(range.firstEntry + (index - range.firstIndex));
+            return QString(_blob.constData() + entry.valueOffset, entry.valueLength);
+        }
+    }
+    return defaultValue;
+}
+
+quint32 TblStringTable::indexOfKey(const QString &key) const
+{
+    if (_isHashBuilt)
+    {
+        quint64 hash = hashOf(key.constData(), key.size());
+        quint32 seed = _bucketSeeds.at((hash >> 32) % _bucketSeeds.size());
+        if (!seed)
+            return kNotFound;
+        int entry = _slotEntries.at(slotOf(hash, seed, _slotEntries.size()));
+        return entryHasKey(entry, key) ? indexOfEntry(entry) : kNotFound;
+    }
+
+    for (int i = _entries.size() - 1; i >= 0; --i)
+        if (entryHasKey(i, key))
+            return indexOfEntry(i);
+    return kNotFound;
+}
+
+quint32 TblStringTable::indexOfValue(const QString &value) const
+{
+    for (int i = 0; i < _entries.size(); ++i)
+    {
+        const Entry &entry = _entries.at(i);
+        if (entry.valueLength == static_cast<quint32>(value.size()) && !memcmp(_blob.constData() + entry.valueOffset, value.constData(), value.size() * sizeof(QChar)))
+            return indexOfEntry(i);
+    }
+    return kNotFound;
+}
+
+QString TblStringTable::valueForKey(const QString &key) const
+{
+    quint32 index = indexOfKey(key);
+    return index == kNotFound ? QString() : value(index);
+}
+
+// FNV-1a over UTF-16 code units
+quint64 TblStringTable::hashOf(const QChar *s, int length)
+{
+    quint64 hash = Q_UINT64_C(14695981039346656037);
+    for (int i = 0; i < length; ++i)
+    {
+        hash ^= s[i].unicode();
+        hash *= Q_UINT64_C(1099511628211);
+    }
+    return hash;
+}
+
+int TblStringTable::slotOf(quint64 hash, quint32 seed, int slotsCount)
+{
+    quint64 x = hash ^ (seed * Q_UINT64_C(0x9E3779B97F4A7C15));
+    x ^= x >> 33;
+    x *= Q_UINT64_C(0xFF51AFD7ED558CCD);
+    x ^= x >> 33;
+    x *= Q_UINT64_C(0xC4CEB9FE1A85EC53);
+    x ^= x >> 33;
+    return static_cast<int>(x % static_cast<quint64>(slotsCount));
+}
+
+quint32 TblStringTable::indexOfEntry(int entry) const
+{
+    for (int i = _ranges.size() - 1; i >= 0; --i)
+        if (entry >= _ranges.at(i).firstEntry)
+            return _ranges.at(i).firstIndex + (entry - _ranges.at(i).firstEntry);
+    return kNotFound;
+}
+
+bool TblStringTable::entryHasKey(int entry, const QString &key) const
+{
+    const Entry &e = _entries.at(entry);
+    return e.keyLength == static_cast<quint32>(key.size()) && !memcmp(_blob.constData() + e.keyOffset, key.constData(), key.size() * sizeof(QChar));
+}
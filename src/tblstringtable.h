@@ -0,0 +1,53 @@
+#ifndef TBLSTRINGTABLE_H
+#define TBLSTRINGTABLE_H
+
+#include <QString>
+#include <QVector>
+
+
+// Strings of the .tbl files (string, patchstring, expansionstring). Keys and values live in one UTF-16 blob addressed by offsets,
+// keys are found through a minimal perfect hash built by buildHash(), so a key lookup is one hash and one comparison.
+// ItemDataBase::StringTable() fills it once for the locale of the run, a language switch takes effect after restart like the other localized tables.
+class TblStringTable
+{
+public:
+    static const quint32 kNotFound;
+
+    TblStringTable() : _isHashBuilt(false) {}
+
+    void append(quint32 index, const QString &key, const QString &value); // indexes must grow, a repeated key refers to its last index
+    void buildHash(); // call after the last append(), key lookups are linear without it
+
+    bool isEmpty() const { return _entries.isEmpty(); }
+    int size() const { return _entries.size(); }
+
+    QString value(quint32 index, const QString &defaultValue = QString()) const;
+    quint32 indexOfKey(const QString &key) const;
+    quint32 indexOfValue(const QString &value) const; // first index with this string, linear search
+    QString valueForKey(const QString &key) const;
+
+private:
+    struct Entry
+    {
+        quint32 keyOffset, keyLength, valueOffset, valueLength;
+    };
+    struct Range // consecutive indexes
+    {
+        quint32 firstIndex;
+        int firstEntry, count;
+    };
+
+    QString _blob;
+    QVector<Entry> _entries;
+    QVector<Range> _ranges;
+    QVector<quint32> _bucketSeeds; // 0 for empty buckets
+    QVector<int> _slotEntries;     // one slot per distinct key
+    bool _isHashBuilt;
+
+    static quint64 hashOf(const QChar *s, int length);
+    static int slotOf(quint64 hash, quint32 seed, int slotsCount);
+    quint32 indexOfEntry(int entry) const;
+    bool entryHasKey(int entry, const QString &key) const;
+};
+
+#endif // TBLSTRINGTABLE_H
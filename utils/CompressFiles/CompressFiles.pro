@@ -14,4 +14,8 @@ QT -= gui
 CONFIG += console
 CONFIG -= app_bundle
 
-SOURCES += main.cpp
+INCLUDEPATH += ../../src
+
+SOURCES += main.cpp \
+           ../../src/chunkeddatafile.cpp
+HEADERS += ../../src/chunkeddatafile.h
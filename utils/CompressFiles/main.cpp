@@ -1,9 +1,9 @@
+#include "chunkeddatafile.h"
+
 #include <QFile>
 #include <QFileInfo>
 #include <QDirIterator>
 
-#define CRC_OF_BYTEARRAY(byteArray) qChecksum(byteArray.constData(), byteArray.length())
-
 bool compressFile(const QFileInfo &fi)
 {
     QFile in(fi.filePath());
@@ -21,11 +21,12 @@ bool compressFile(const QFileInfo &fi)
         qWarning("error creating file '%s'\nreason: %s", qPrintable(out.fileName()), qPrintable(out.errorString()));
         return false;
     }
-    QByteArray compressedData = qCompress(fileData);
-    quint16 crcCompressed = CRC_OF_BYTEARRAY(compressedData), crcOriginal = CRC_OF_BYTEARRAY(fileData);
-    const char crcData[4] = {crcCompressed & 255, crcCompressed >> 8, crcOriginal & 255, crcOriginal >> 8};
-    out.write(crcData, 4);
-    out.write(compressedData);
+    QByteArray compressedData = ChunkedDataFile::compressed(fileData);
+    if (out.write(compressedData) != compressedData.size())
+    {
+        qWarning("error writing file '%s'\nreason: %s", qPrintable(out.fileName()), qPrintable(out.errorString()));
+        return false;
+    }
 
     return true;
 }
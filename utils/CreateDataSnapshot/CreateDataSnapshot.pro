@@ -0,0 +1,19 @@
+TEMPLATE = app
+TARGET = CreateDataSnapshot
+DESTDIR = ../txt_parser
+
+QT += core
+QT -= gui
+
+CONFIG += console
+CONFIG -= app_bundle
+
+INCLUDEPATH += ../../src
+
+SOURCES += main.cpp \
+           ../../src/chunkeddatafile.cpp \
+           ../../src/datasnapshot.cpp \
+           ../../src/itembitbuffer.cpp
+HEADERS += ../../src/chunkeddatafile.h \
+           ../../src/datasnapshot.h \
+           ../../src/itembitbuffer.h
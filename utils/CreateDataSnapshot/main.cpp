@@ -0,0 +1,37 @@
+#include "datasnapshot.h"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QStringList>
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2)
+    {
+        qDebug("usage: createdatasnapshot <resources/data path> [locales...]\nby default snapshots are created for every locale directory that has items.dat");
+        return 1;
+    }
+
+    QDir dataDir(QString::fromLocal8Bit(argv[1]));
+    QStringList locales;
+    for (int i = 2; i < argc; ++i)
+        locales << QString::fromLocal8Bit(argv[i]);
+    if (locales.isEmpty())
+        foreach (const QString &locale, dataDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot))
+            if (QFileInfo(dataDir.filePath(locale + "/items.dat")).isFile())
+                locales << locale;
+
+    int result = 0;
+    foreach (const QString &locale, locales)
+    {
+        QString error, snapshotPath = dataDir.filePath(DataSnapshot::fileName(locale));
+        if (DataSnapshot::generate(dataDir.path(), locale, snapshotPath, &error))
+            qDebug("created '%s'", qPrintable(snapshotPath));
+        else
+        {
+            qWarning("error creating snapshot for locale '%s'\nreason: %s", qPrintable(locale), qPrintable(error));
+            result = 1;
+        }
+    }
+    return result;
+}
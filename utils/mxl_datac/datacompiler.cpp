@@ -0,0 +1,922 @@
+#include "datacompiler.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFuture>
+
+#if IS_QT5
+#include <QtConcurrent/QtConcurrentMap>
+#else
+#include <QtConcurrentMap>
+#endif
+
+#include <algorithm>
+#include <cstdlib>
+
+
+static const char *const kFixedPropertyKeys[] = {"prop", "param", "min", "max"}; // columns of any fixed property in .txt
+static const int kFixedPropertyKeysSize = 4;
+
+static const char *const kSubtypes[] = {"weapon", "armor", "shield"};
+static const char *const kSubtypeKeys[] = {"code", "param", "value"};
+
+static const char *const kBaseStatsKeys[] = {"strength", "dexterity", "energy", "vitality", "stamina", "lifePerLevel", "staminaPerLevel", "manaPerLevel", "lifePerPoint", "staminaPerPoint", "manaPerPoint"};
+static const int kBaseStatsKeysSize = 11;
+
+// itemstatcost column with the .tbl key -> field with the string
+static const char *const kDescKeys[][2] = {
+    {"descstrpos", "descPositive"},
+    {"descstrneg", "descNegative"},
+    {"descstr2",   "descStringAdd"},
+    {"dgrpstrpos", "descGroupPositive"},
+    {"dgrpstrneg", "descGroupNegative"},
+    {"dgrpstr2",   "descGroupStringAdd"},
+};
+static const int kDescKeysSize = 6;
+
+static const QByteArray kItemName("name"), kNameStr("namestr"), kSpellDescStr("spelldescstr"), kTbl("tbl");
+
+static QList<QByteArray> fixedPropertyKeys(int propertiesSize, const QByteArray &prefix = QByteArray())
+{
+    QList<QByteArray> keys;
+    for (int i = 1; i <= propertiesSize; ++i)
+        for (int j = 0; j < kFixedPropertyKeysSize; ++j)
+            keys << prefix + kFixedPropertyKeys[j] + QByteArray::number(i);
+    return keys;
+}
+
+static void addFixedPropertyColumns(QHash<QByteArray, int> *columns, int firstColumn, int propertiesSize, const QByteArray &prefix = QByteArray())
+{
+    QList<QByteArray> keys = fixedPropertyKeys(propertiesSize, prefix);
+    for (int i = 0; i < keys.size(); ++i)
+        columns->insert(keys.at(i), firstColumn + i);
+}
+
+static QList<QByteArray> setsPropertiesKeys()   { return fixedPropertyKeys(8, "part_") + fixedPropertyKeys(8, "full_"); }
+static QList<QByteArray> greenPropertiesKeys()  { return fixedPropertyKeys(10); }
+static QList<QByteArray> gemKeys()
+{
+    QList<QByteArray> keys;
+    for (int i = 0; i < 3; ++i)
+        for (int j = 1; j <= 3; ++j)
+            for (int k = 0; k < 3; ++k)
+                keys << kSubtypes[i] + QByteArray::number(j) + kSubtypeKeys[k];
+    std::sort(keys.begin(), keys.end());
+    return keys;
+}
+
+static int classCode(const QByteArray &classString)
+{
+    static const char *const kClasses[] = {"ama", "sor", "nec", "pal", "bar", "dru", "ass"};
+    for (int i = 0; i < 7; ++i)
+        if (classString == kClasses[i])
+            return i;
+    return -1;
+}
+
+// Perl's numeric value of a string: the longest leading number, 0 if there is none
+static double perlNumber(const QByteArray &s)
+{
+    return s.isEmpty() ? 0 : std::strtod(s.constData(), 0);
+}
+
+static QByteArray perlInt(const QByteArray &s) // printf "%d"
+{
+    return QByteArray::number(static_cast<qint64>(perlNumber(s)));
+}
+
+static QByteArray escapeHtml(QByteArray s)
+{
+    return s.replace('<', "&lt;").replace('>', "&gt;");
+}
+
+// $tbl->{$key} // $key
+static QByteArray tblString(const QHash<QByteArray, QByteArray> &tbl, const QByteArray &key)
+{
+    QHash<QByteArray, QByteArray>::const_iterator it = tbl.constFind(key);
+    return it != tbl.constEnd() ? it.value() : key;
+}
+
+// $tbl->{$key} // $tbl->{dummy}, used for item names
+static QByteArray tblName(const QHash<QByteArray, QByteArray> &tbl, const QByteArray &key)
+{
+    QHash<QByteArray, QByteArray>::const_iterator it = tbl.constFind(key);
+    return it != tbl.constEnd() ? it.value() : tbl.value("dummy");
+}
+
+static QByteArray joined(const QList<QByteArray> &list, char separator)
+{
+    QByteArray result;
+    for (int i = 0; i < list.size(); ++i)
+    {
+        if (i)
+            result += separator;
+        result += list.at(i);
+    }
+    return result;
+}
+
+// split(/\t/, $line) drops trailing empty fields, so only columns before them are 'defined'
+static QList<QByteArray> splitTsvLine(const QByteArray &line)
+{
+    QList<QByteArray> columns = line.split('\t');
+    while (!columns.isEmpty() && columns.last().isEmpty())
+        columns.removeLast();
+    return columns;
+}
+
+
+QString DataCompiler::tableName(Table table)
+{
+    switch (table)
+    {
+    case ItemTypes:   return "itemtypes";
+    case Sets:        return "sets";
+    case BaseStats:   return "basestats";
+    case Items:       return "items";
+    case Uniques:     return "uniques";
+    case SetItems:    return "setitems";
+    case Skills:      return "skills";
+    case Props:       return "props";
+    case Monsters:    return "monsters";
+    case Runewords:   return "rw";
+    case Socketables: return "socketables";
+    default:          return QString();
+    }
+}
+
+QStringList DataCompiler::stringFiles()
+{
+    return QStringList() << "string" << "expansionstring" << "patchstring";
+}
+
+QStringList DataCompiler::availableLocales() const
+{
+    return QDir(_sourcePath + "/tbl").entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+}
+
+bool DataCompiler::load(const QStringList &locales, QString *error /*= 0*/)
+{
+    QList<TxtSource> sources = txtSources();
+    _strings.clear();
+    foreach (const QString &locale, locales)
+    {
+        _strings[locale].locale = locale;
+        _strings[locale].path = QString("%1/tbl/%2").arg(_sourcePath, locale);
+    }
+
+    QFuture<void> sourcesFuture = QtConcurrent::map(sources, parseTxt), stringsFuture = QtConcurrent::map(_strings, readStrings);
+    sourcesFuture.waitForFinished();
+    stringsFuture.waitForFinished();
+
+    QStringList errors;
+    foreach (const TxtSource &source, sources)
+        if (!source.error.isEmpty())
+            errors << source.error;
+    foreach (const Strings &strings, _strings)
+        if (!strings.error.isEmpty())
+            errors << strings.error;
+    if (!errors.isEmpty())
+    {
+        if (error)
+            *error = errors.join("\n");
+        return false;
+    }
+
+    _statIds.clear();
+    for (int i = 0; i < _itemProperties.size(); ++i)
+    {
+        QByteArray stat = _itemProperties.at(i).value("stat");
+        if (!stat.isEmpty() && !_statIds.contains(stat))
+            _statIds[stat] = i;
+    }
+
+    // sets are translated only in setitems, so their fixed properties can be expanded once
+    QList<QByteArray> keys = setsPropertiesKeys();
+    for (RecordMap::iterator it = _sets.begin(); it != _sets.end(); ++it)
+        expandSetProperties(keys, &it.value(), 0);
+    // txtparser.pl also output empty rows for the skipped sets that set items refer to
+    foreach (const Record &setItem, _setItems)
+        if (setItem.contains("setKey"))
+            _sets[setItem.value("setKey")];
+
+    _itemTypesByCode.clear();
+    for (RecordMap::const_iterator it = _itemTypes.constBegin(); it != _itemTypes.constEnd(); ++it)
+        if (!_itemTypesByCode.contains(it.value().value("code0")))
+            _itemTypesByCode[it.value().value("code0")] = &it.value();
+    return true;
+}
+
+QByteArray DataCompiler::generate(Table table, const QString &locale /*= QString()*/) const
+{
+    if (!isLocalized(table))
+    {
+        switch (table)
+        {
+        case ItemTypes: return generateItemTypes();
+        case Sets:      return generateSets();
+        case BaseStats: return generateBaseStats();
+        default:        return QByteArray();
+        }
+    }
+
+    QMap<QString, Strings>::const_iterator it = _strings.constFind(locale);
+    if (it == _strings.constEnd())
+        return QByteArray();
+    const Strings &strings = it.value();
+    switch (table)
+    {
+    case Items:       return generateItems(strings);
+    case Uniques:     return generateUniques(strings);
+    case SetItems:    return generateSetItems(strings);
+    case Skills:      return generateSkills(strings);
+    case Props:       return generateProps(strings);
+    case Monsters:    return generateMonsters(strings);
+    case Runewords:   return generateRunewords(strings);
+    case Socketables: return generateSocketables(strings);
+    default:          return QByteArray();
+    }
+}
+
+QByteArray DataCompiler::statIdsHeader(const QString &headerName) const
+{
+    QByteArray guard = headerName.toUpper().replace('.', '_').toLatin1();
+    QByteArray header = "// Generated by mxl_datac from itemstatcost.txt, don't edit.\n\n";
+    header += "#ifndef " + guard + "\n#define " + guard + "\n\n\n";
+    header += "namespace ItemStatIds\n{\n    enum\n    {\n";
+    bool isFirst = true;
+    for (int i = 0; i < _itemProperties.size(); ++i)
+    {
+        QByteArray stat = _itemProperties.at(i).value("stat");
+        if (stat.isEmpty() || _statIds.value(stat) != i)
+            continue;
+
+        // item_armor_percent -> ItemArmorPercent
+        QByteArray name;
+        bool isWordStart = true;
+        foreach (char c, stat)
+        {
+            if (!((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')))
+                isWordStart = true;
+            else
+            {
+                name += isWordStart && c >= 'a' && c <= 'z' ? static_cast<char>(c - 'a' + 'A') : c;
+                isWordStart = false;
+            }
+        }
+        if (name.isEmpty() || (name.at(0) >= '0' && name.at(0) <= '9'))
+            name.prepend("Stat");
+
+        header += (isFirst ? "        " : ",\n        ") + name + " = " + QByteArray::number(i);
+        isFirst = false;
+    }
+    header += "\n    };\n}\n\n#endif // " + guard + "\n";
+    return header;
+}
+
+
+// keys interpretation (same as parsetxt()): index/key column rows are merged, only non-empty values are taken,
+// rows matching any skip rule are ignored, first line is the header
+void DataCompiler::parseTxt(TxtSource &source)
+{
+    QFile f(source.fileName);
+    if (!f.open(QIODevice::ReadOnly))
+    {
+        source.error = QString("error opening file '%1'\nreason: %2").arg(source.fileName, f.errorString());
+        return;
+    }
+    QList<QByteArray> lines = f.readAll().split('\n');
+    if (!lines.isEmpty() && lines.last().isEmpty())
+        lines.removeLast();
+
+    for (int row = 1; row < lines.size(); ++row)
+    {
+        QList<QByteArray> columns = splitTsvLine(lines.at(row));
+
+        bool skip = false;
+        foreach (const SkipRule &rule, source.skipRules)
+        {
+            if (rule.column < columns.size() && (rule.isExactMatch ? columns.at(rule.column) == rule.value : columns.at(rule.column).contains(rule.value)))
+            {
+                skip = true;
+                break;
+            }
+        }
+        if (skip)
+            continue;
+
+        Record *record = 0;
+        switch (source.keyType)
+        {
+        case TxtSource::RowNumber:
+            while (source.list->size() <= row)
+                source.list->append(Record());
+            record = &(*source.list)[row];
+            break;
+        case TxtSource::IndexColumn:
+        {
+            if (source.keyColumn >= columns.size())
+                continue;
+            int index = static_cast<int>(perlNumber(columns.at(source.keyColumn)));
+            if (index < 0)
+                continue;
+            while (source.list->size() <= index)
+                source.list->append(Record());
+            record = &(*source.list)[index];
+            break;
+        }
+        case TxtSource::KeyColumn:
+        {
+            if (source.keyColumn >= columns.size())
+                continue;
+            QByteArray key = columns.at(source.keyColumn);
+            if (key.size() > 2 && key.startsWith('"') && key.endsWith('"')) // stupid Excel may add double-quotes
+                key = key.mid(1, key.size() - 2);
+            record = &(*source.map)[key];
+            break;
+        }
+        }
+
+        for (QHash<QByteArray, int>::const_iterator it = source.columns.constBegin(); it != source.columns.constEnd(); ++it)
+            if (it.value() < columns.size() && !columns.at(it.value()).isEmpty())
+                record->insert(it.key(), columns.at(it.value()));
+    }
+
+    // rows that only had empty values don't exist in Perl
+    if (source.map)
+        for (RecordMap::iterator it = source.map->begin(); it != source.map->end();)
+            it = it.value().isEmpty() ? source.map->erase(it) : it + 1;
+    if (source.list)
+        while (!source.list->isEmpty() && source.list->last().isEmpty())
+            source.list->removeLast();
+}
+
+
+void DataCompiler::readStrings(Strings &strings)
+{
+    // files override each other's keys, lines look like "key"<tab>"string"
+    foreach (const QString &fileName, stringFiles())
+    {
+        QFile f(QString("%1/%2.txt").arg(strings.path, fileName));
+        if (!f.open(QIODevice::ReadOnly))
+        {
+            strings.error = QString("error opening file '%1'\nreason: %2").arg(f.fileName(), f.errorString());
+            return;
+        }
+        foreach (const QByteArray &line, f.readAll().split('\n'))
+        {
+            int keyStart = line.indexOf('"') + 1;
+            int keyEnd = keyStart ? line.indexOf("\"\t\"", keyStart + 1) : -1;
+            if (keyEnd == -1 || !line.endsWith('"') || line.size() - 1 < keyEnd + 3)
+                continue;
+            strings.tbl[line.mid(keyStart, keyEnd - keyStart)] = line.mid(keyEnd + 3, line.size() - 1 - (keyEnd + 3));
+        }
+    }
+
+    if (strings.locale == "en")
+        return;
+    // rune letters inserted in items are translated separately, lines look like english_name<tab>translated_name
+    QFile f(strings.path + "/runes.txt");
+    if (!f.open(QIODevice::ReadOnly))
+    {
+        qWarning("inserted runes will stay in English - failed to open %s: %s", qPrintable(f.fileName()), qPrintable(f.errorString()));
+        return;
+    }
+    foreach (const QByteArray &line, f.readAll().split('\n'))
+    {
+        int tab = line.indexOf('\t');
+        if (tab > 0 && tab + 1 < line.size())
+            strings.runeLetters[line.left(tab)] = line.mid(tab + 1);
+    }
+}
+
+DataCompiler::TxtSource DataCompiler::txtSource(const QString &fileName, TxtSource::KeyType keyType, int keyColumn, RecordList *list, RecordMap *map) const
+{
+    TxtSource source;
+    source.fileName = QString("%1/txt/%2").arg(_sourcePath, fileName);
+    source.keyType = keyType;
+    source.keyColumn = keyColumn;
+    source.list = list;
+    source.map = map;
+    if (list)
+        list->clear();
+    else
+        map->clear();
+    return source;
+}
+
+QList<DataCompiler::TxtSource> DataCompiler::txtSources()
+{
+    QList<TxtSource> sources;
+
+    TxtSource properties = txtSource("properties.tsv", TxtSource::KeyColumn, 0, 0, &_properties);
+    properties.columns["param1"] = 6;
+    for (int i = 0; i < 7; ++i)
+        properties.columns["stat" + QByteArray::number(i + 1)] = 8 + i * 4;
+    sources << properties;
+
+    TxtSource itemStatCost = txtSource("itemstatcost.tsv", TxtSource::IndexColumn, 1, &_itemProperties, 0);
+    itemStatCost.columns["stat"] = 0;
+    itemStatCost.columns["bits"] = 5;
+    itemStatCost.columns["add"] = 6;
+    itemStatCost.columns["saveParamBits"] = 7;
+    itemStatCost.columns["descpriority"] = 15;
+    itemStatCost.columns["descfunc"] = 16;
+    itemStatCost.columns["descval"] = 17;
+    itemStatCost.columns["bitsSave"] = 32;
+    itemStatCost.columns["bitsParamSave"] = 33;
+    itemStatCost.columns["dgrp"] = 47;
+    itemStatCost.columns["dgrpfunc"] = 48;
+    itemStatCost.columns["dgrpval"] = 49;
+    static const int kDescColumns[kDescKeysSize] = {18, 19, 20, 50, 51, 52};
+    for (int i = 0; i < kDescKeysSize; ++i)
+        itemStatCost.columns[kDescKeys[i][0]] = kDescColumns[i];
+    sources << itemStatCost;
+
+    TxtSource uniques = txtSource("uniqueitems.tsv", TxtSource::RowNumber, 0, &_uniques, 0);
+    uniques.columns["iName"] = 0;
+    uniques.columns["ilvl"] = 4;
+    uniques.columns["rlvl"] = 5;
+    uniques.columns["image"] = 67;
+    sources << uniques;
+
+    SkipRule oldSetRule = {0, "old LoD", true};
+    TxtSource sets = txtSource("sets.tsv", TxtSource::KeyColumn, 0, 0, &_sets);
+    sets.columns[kTbl] = 1;
+    addFixedPropertyColumns(&sets.columns, 8, 8, "part_"); // partial bonuses
+    addFixedPropertyColumns(&sets.columns, 40, 8, "full_"); // full ones
+    oldSetRule.column = 2;
+    sets.skipRules << oldSetRule;
+    sources << sets;
+
+    TxtSource setItems = txtSource("setitems.tsv", TxtSource::RowNumber, 0, &_setItems, 0);
+    setItems.columns["iIName"] = 0;
+    setItems.columns["setKey"] = 1;
+    setItems.columns["rlvl"] = 8;
+    setItems.columns["image"] = 87;
+    setItems.columns["addfunc"] = 94;
+    addFixedPropertyColumns(&setItems.columns, 57, 10);
+    oldSetRule.column = 7;
+    setItems.skipRules << oldSetRule;
+    sources << setItems;
+
+    TxtSource armor = txtSource("armor.tsv", TxtSource::KeyColumn, 0, 0, &_armor);
+    armor.columns[kItemName] = 1;
+    armor.columns["type"] = 2;
+    armor.columns["type2"] = 3;
+    armor.columns["rstr"] = 13;
+    armor.columns["rdex"] = 14;
+    armor.columns["rlvl"] = 19;
+    armor.columns[kNameStr] = 22;
+    armor.columns["w"] = 32;
+    armor.columns["h"] = 33;
+    armor.columns["image"] = 38;
+    sources << armor;
+
+    TxtSource weapons = txtSource("weapons.tsv", TxtSource::KeyColumn, 0, 0, &_weapons);
+    weapons.columns[kItemName] = 1;
+    weapons.columns["type"] = 2;
+    weapons.columns["type2"] = 3;
+    weapons.columns[kNameStr] = 5;
+    weapons.columns["1hMinDmg"] = 13;
+    weapons.columns["1hMaxDmg"] = 14;
+    weapons.columns["1h2h"] = 15;
+    weapons.columns["2h"] = 16;
+    weapons.columns["2hMinDmg"] = 17;
+    weapons.columns["2hMaxDmg"] = 18;
+    weapons.columns["throwMinDmg"] = 19;
+    weapons.columns["throwMaxDmg"] = 20;
+    weapons.columns["strBonus"] = 24;
+    weapons.columns["dexBonus"] = 25;
+    weapons.columns["rstr"] = 26;
+    weapons.columns["rdex"] = 27;
+    weapons.columns["rlvl"] = 31;
+    weapons.columns["w"] = 44;
+    weapons.columns["h"] = 45;
+    weapons.columns["stackable"] = 46;
+    weapons.columns["image"] = 51;
+    weapons.columns["quest"] = 68;
+    sources << weapons;
+
+    TxtSource misc = txtSource("misc.tsv", TxtSource::KeyColumn, 5, 0, &_misc);
+    misc.columns[kItemName] = 0;
+    misc.columns[kNameStr] = 7;
+    misc.columns["type"] = 8;
+    misc.columns["type2"] = 9;
+    misc.columns["rlvl"] = 14;
+    misc.columns["w"] = 25;
+    misc.columns["h"] = 26;
+    misc.columns["image"] = 31;
+    misc.columns["stackable"] = 49;
+    misc.columns["quest"] = 53;
+    misc.columns[kSpellDescStr] = 70;
+    sources << misc;
+
+    TxtSource skills = txtSource("skills.tsv", TxtSource::IndexColumn, 1, &_skills, 0);
+    skills.columns["dbgname"] = 0;
+    skills.columns["class"] = 2;
+    skills.columns["internalName"] = 3;
+    skills.columns["srvmissile"] = 8;
+    skills.columns["srvmissilea"] = 11;
+    skills.columns["srvmissileb"] = 12;
+    skills.columns["srvmissilec"] = 13;
+    sources << skills;
+
+    TxtSource skillDescs = txtSource("skilldesc.tsv", TxtSource::KeyColumn, 0, 0, &_skillDescs);
+    skillDescs.columns["tab"] = 1;
+    skillDescs.columns["row"] = 2;
+    skillDescs.columns["col"] = 3;
+    skillDescs.columns["image"] = 8;
+    skillDescs.columns["dscname"] = 9;
+    sources << skillDescs;
+
+    TxtSource monsters = txtSource("monstats.tsv", TxtSource::RowNumber, 0, &_monsters, 0);
+    monsters.columns[kNameStr] = 6;
+    sources << monsters;
+
+    TxtSource runewords = txtSource("runes.tsv", TxtSource::RowNumber, 0, &_runewords, 0);
+    runewords.columns[kTbl] = 0;
+    for (int i = 1; i <= 6; ++i)
+    {
+        runewords.columns["allowedType" + QByteArray::number(i)] = i + 2;
+        runewords.columns["rune" + QByteArray::number(i)] = i + 11;
+    }
+    SkipRule disabledRule = {1, "0", true}, jewelRule = {12, "jew", true};
+    runewords.skipRules << disabledRule << jewelRule;
+    sources << runewords;
+
+    TxtSource gems = txtSource("gems.tsv", TxtSource::KeyColumn, 3, 0, &_gems);
+    gems.columns[kItemName] = 0;
+    gems.columns["letter"] = 1;
+    int column = 5; // weaponMod1Code
+    for (int i = 0; i < 3; ++i)
+    {
+        for (int j = 1; j <= 3; ++j)
+        {
+            for (int k = 0; k < 3; ++k)
+                gems.columns[kSubtypes[i] + QByteArray::number(j) + kSubtypeKeys[k]] = column++;
+            ++column; // skip 'max'
+        }
+    }
+    sources << gems;
+
+    TxtSource itemTypes = txtSource("itemtypes.tsv", TxtSource::KeyColumn, 0, 0, &_itemTypes);
+    itemTypes.columns["code0"] = 1;
+    itemTypes.columns["equiv1"] = 8;
+    itemTypes.columns["equiv2"] = 9;
+    itemTypes.columns["bodyLoc"] = 12;
+    itemTypes.columns["class"] = 34;
+    for (int i = 1; i <= 6; ++i)
+        itemTypes.columns["invgfx" + QByteArray::number(i)] = 35 + i;
+    sources << itemTypes;
+
+    TxtSource baseStats = txtSource("charstats.tsv", TxtSource::RowNumber, 0, &_baseStats, 0);
+    for (int i = 0; i < 4; ++i)
+        baseStats.columns[kBaseStatsKeys[i]] = i + 1;
+    baseStats.columns[kBaseStatsKeys[4]] = 6;
+    for (int i = 5; i < kBaseStatsKeysSize; ++i)
+        baseStats.columns[kBaseStatsKeys[i]] = i + 13;
+    SkipRule expansionRule = {0, "Expansion", false};
+    baseStats.skipRules << expansionRule;
+    sources << baseStats;
+
+    return sources;
+}
+
+
+QByteArray DataCompiler::generateItemTypes() const
+{
+    QByteArray out = "#code\tequiv\tvarImages\tname\n";
+    for (RecordMap::const_iterator it = _itemTypes.constBegin(); it != _itemTypes.constEnd(); ++it)
+    {
+        const Record &itemType = it.value();
+        if (!itemType.contains("equiv1") || !itemType.contains("code0"))
+            continue;
+
+        out += itemType.value("code0") + "\t" + itemType.value("equiv1");
+        if (itemType.contains("equiv2"))
+            out += "," + itemType.value("equiv2");
+
+        QList<QByteArray> varImages;
+        for (int i = 1; i <= 6; ++i)
+        {
+            QByteArray varImage = itemType.value("invgfx" + QByteArray::number(i));
+            if (varImage.isEmpty())
+                break;
+            varImages << varImage;
+        }
+        out += "\t" + joined(varImages, ',') + "\t" + it.key() + "\n";
+    }
+    return out;
+}
+
+QByteArray DataCompiler::generateSets() const
+{
+    QList<QByteArray> keys = setsPropertiesKeys();
+    QByteArray out = "#index\t" + joined(keys, '\t') + "\n";
+    for (RecordMap::const_iterator it = _sets.constBegin(); it != _sets.constEnd(); ++it)
+    {
+        out += it.key();
+        foreach (const QByteArray &key, keys)
+            out += "\t" + it.value().value(key);
+        out += "\n";
+    }
+    return out;
+}
+
+QByteArray DataCompiler::generateBaseStats() const
+{
+    QByteArray out = "#classcode";
+    for (int i = 0; i < kBaseStatsKeysSize; ++i)
+        out += QByteArray("\t") + kBaseStatsKeys[i];
+    out += "\n";
+
+    int classCode = 0;
+    foreach (const Record &baseStats, _baseStats)
+    {
+        if (baseStats.isEmpty())
+            continue;
+        out += QByteArray::number(classCode++);
+        for (int i = 0; i < kBaseStatsKeysSize; ++i)
+            out += "\t" + baseStats.value(kBaseStatsKeys[i]);
+        out += "\n";
+    }
+    return out;
+}
+
+QByteArray DataCompiler::generateItems(const Strings &strings) const
+{
+    static const char *const kDamageKeys[] = {"1hMinDmg", "1hMaxDmg", "2hMinDmg", "2hMaxDmg", "throwMinDmg", "throwMaxDmg", "image", "quest", "strBonus", "dexBonus"};
+
+    QByteArray out = "#code\tname\tspelldescstr\twidth\theight\tgentype\tstackable\trlvl\trstr\trdex\t1h2h\t2h\t";
+    out += "1hMinDmg\t1hMaxDmg\t2hMinDmg\t2hMaxDmg\tthrowMinDmg\tthrowMaxDmg\timage\tquest\tstrBonus\tdexBonus\t";
+    out += "type\tsockettype\tclass\n"; // these columns are treated specially
+
+    const RecordMap *itemsMaps[] = {&_armor, &_weapons, &_misc};
+    for (int itemType = 0; itemType < 3; ++itemType)
+    {
+        for (RecordMap::const_iterator it = itemsMaps[itemType]->constBegin(); it != itemsMaps[itemType]->constEnd(); ++it)
+        {
+            const Record &item = it.value();
+            if (!item.contains("w"))
+                continue;
+
+            QByteArray spellDesc = item.value(kSpellDescStr), stackable = item.value("stackable"), type = item.value("type");
+            QList<QByteArray> columns;
+            columns << it.key() << tblName(strings.tbl, item.contains(kNameStr) ? item.value(kNameStr) : it.key())
+                    << (!spellDesc.isEmpty() && strings.tbl.contains(spellDesc) ? strings.tbl.value(spellDesc) : spellDesc)
+                    << perlInt(item.value("w")) << perlInt(item.value("h")) << QByteArray::number(itemType)
+                    << (perlNumber(stackable) > 0 ? stackable : QByteArray())
+                    << perlInt(item.value("rlvl")) << perlInt(item.value("rstr")) << perlInt(item.value("rdex"))
+                    << item.value("1h2h") << item.value("2h");
+            for (int i = 0; i < 10; ++i)
+                columns << item.value(kDamageKeys[i]);
+            out += joined(columns, '\t') + "\t" + type;
+            if (item.contains("type2"))
+                out += "," + item.value("type2");
+            out += "\t";
+
+            // find which class it belongs to
+            if (const Record *itemTypeRecord = _itemTypesByCode.value(type))
+            {
+                // to determine item type when parsing socketables: 0 - shield, 1 - weapon, nothing - armor
+                if (itemTypeRecord->value("bodyLoc") == "rarm")
+                    out += QByteArray::number(itemType);
+                QByteArray classString = itemTypeRecord->value("class");
+                int code = classCode(classString);
+                out += "\t" + (classString.isEmpty() ? QByteArray("-1") : code != -1 ? QByteArray::number(code) : QByteArray()) + "\n";
+            }
+        }
+    }
+    return out;
+}
+
+QByteArray DataCompiler::generateUniques(const Strings &strings) const
+{
+    QByteArray out = "#index\titem\trlvl\tilvl\timage\n";
+    for (int i = 0; i < _uniques.size(); ++i)
+    {
+        const Record &unique = _uniques.at(i);
+        if (!unique.contains("iName"))
+            continue;
+        out += QByteArray::number(i - 1) + "\t" + escapeHtml(tblString(strings.tbl, unique.value("iName"))) + "\t" + perlInt(unique.value("rlvl"))
+             + "\t" + perlInt(unique.value("ilvl")) + "\t" + unique.value("image") + "\n";
+    }
+    return out;
+}
+
+QByteArray DataCompiler::generateSetItems(const Strings &strings) const
+{
+    QList<QByteArray> keys = greenPropertiesKeys();
+    QByteArray out = "#index\titem\tset\tkey\trlvl\timage\t" + joined(keys, '\t') + "\n";
+    for (int i = 0; i < _setItems.size(); ++i)
+    {
+        const Record &setItem = _setItems.at(i);
+        QByteArray setTblKey = _sets.value(setItem.value("setKey")).value(kTbl);
+        if (!setItem.contains("iIName") || !setItem.contains("setKey") || setTblKey.isEmpty())
+            continue;
+
+        Record record;
+        // if addfunc == 0, then properties are embedded in the item
+        if (perlNumber(setItem.value("addfunc")) > 0)
+            expandSetProperties(keys, &record, &setItem);
+
+        out += QByteArray::number(i - 2) + "\t" + escapeHtml(tblString(strings.tbl, setItem.value("iIName"))) + "\t" + escapeHtml(tblString(strings.tbl, setTblKey))
+             + "\t" + setItem.value("setKey") + "\t" + perlInt(setItem.value("rlvl")) + "\t" + setItem.value("image");
+        foreach (const QByteArray &key, keys)
+            out += "\t" + record.value(key);
+        out += "\n";
+    }
+    return out;
+}
+
+QByteArray DataCompiler::generateSkills(const Strings &strings) const
+{
+    QByteArray out = "#code\tname\tclass\ttab\trow\tcol\timage\n";
+    for (int i = 0; i < _skills.size(); ++i)
+    {
+        const Record &skill = _skills.at(i);
+        out += QByteArray::number(i);
+        if (!skill.contains("internalName"))
+        {
+            out += "\t\t" + QByteArray::number(classCode(skill.value("class"))) + "\t\t\t\t\n";
+            continue;
+        }
+
+        Record desc = _skillDescs.value(skill.value("internalName"));
+        out += "\t" + (desc.contains("dscname") ? escapeHtml(tblString(strings.tbl, desc.value("dscname"))) : QByteArray()) + "\t" + QByteArray::number(classCode(skill.value("class")))
+             + "\t" + desc.value("tab") + "\t" + desc.value("row") + "\t" + desc.value("col") + "\t" + desc.value("image") + "\n";
+    }
+    return out;
+}
+
+QByteArray DataCompiler::generateProps(const Strings &strings) const
+{
+    RecordList itemProperties = _itemProperties;
+    QHash<QByteArray, QList<int> > groups; // descGroupPositive -> ids
+    for (int i = 0; i < itemProperties.size(); ++i)
+    {
+        Record &property = itemProperties[i];
+        for (int j = 0; j < kDescKeysSize; ++j)
+            if (property.contains(kDescKeys[j][0]))
+            {
+                QByteArray tblKey = property.take(kDescKeys[j][0]);
+                property[kDescKeys[j][1]] = escapeHtml(tblString(strings.tbl, tblKey));
+            }
+        if (property.contains("descGroupPositive"))
+            groups[property.value("descGroupPositive")] << i;
+    }
+
+    // add new field for group properties
+    for (int i = 0; i < itemProperties.size(); ++i)
+    {
+        Record &property = itemProperties[i];
+        if (!property.contains("descGroupPositive"))
+            continue;
+        QList<QByteArray> sameGroupIds;
+        foreach (int id, groups.value(property.value("descGroupPositive")))
+            if (id != i)
+                sameGroupIds << QByteArray::number(id);
+        property["descGroupIDs"] = joined(sameGroupIds, ',');
+    }
+
+    QList<QByteArray> keys = QList<QByteArray>() << "stat" << "bitsSave" << "bitsParamSave" << "bits" << "add" << "saveParamBits"
+                                                 << "descpriority" << "descfunc" << "descval" << "dgrp" << "dgrpfunc" << "dgrpval" << "descGroupIDs";
+    for (int i = 0; i < kDescKeysSize; ++i)
+        keys << kDescKeys[i][1];
+    std::sort(keys.begin(), keys.end());
+
+    QByteArray out = "#code\t" + joined(keys, '\t') + "\n";
+    for (int i = 0; i < itemProperties.size(); ++i)
+    {
+        const Record &property = itemProperties.at(i);
+        if (!property.contains("bits") && !property.contains("bitsSave"))
+            continue;
+        out += QByteArray::number(i);
+        foreach (const QByteArray &key, keys)
+            out += "\t" + property.value(key);
+        out += "\n";
+    }
+    return out;
+}
+
+QByteArray DataCompiler::generateMonsters(const Strings &strings) const
+{
+    QByteArray out = "#index\tname\n";
+    for (int i = 0; i < _monsters.size(); ++i)
+        if (_monsters.at(i).contains(kNameStr))
+            out += QByteArray::number(i - 2) + "\t" + escapeHtml(tblString(strings.tbl, _monsters.at(i).value(kNameStr))) + "\n";
+    return out;
+}
+
+QByteArray DataCompiler::generateRunewords(const Strings &strings) const
+{
+    RecordList runewords = _runewords;
+    Record jewelword; // yeah, it's a hack
+    jewelword[kTbl] = "09This";
+    jewelword["allowedType1"] = "weap";
+    jewelword["allowedType2"] = "armo";
+    jewelword["rune1"] = "jew";
+    runewords << jewelword;
+
+    QList<QByteArray> keys;
+    for (int i = 1; i <= 6; ++i)
+        keys << "allowedType" + QByteArray::number(i);
+    keys << kItemName;
+    for (int i = 1; i <= 6; ++i)
+        keys << "rune" + QByteArray::number(i);
+
+    QByteArray out = "#" + joined(keys, '\t') + "\n";
+    foreach (const Record &runeword, runewords)
+    {
+        if (runeword.isEmpty())
+            continue;
+        foreach (const QByteArray &key, keys)
+            out += (key == kItemName ? tblName(strings.tbl, runeword.value(kTbl)) : runeword.value(key)) + "\t";
+        out += "\n";
+    }
+    return out;
+}
+
+QByteArray DataCompiler::generateSocketables(const Strings &strings) const
+{
+    QList<QByteArray> keys = gemKeys();
+    QByteArray out = "#code\tname\tletter\t" + joined(keys, '\t') + "\n";
+    for (RecordMap::const_iterator it = _gems.constBegin(); it != _gems.constEnd(); ++it)
+    {
+        if (it.key().isEmpty()) // skip 'Expansion'
+            continue;
+
+        const Record &gem = it.value();
+        QByteArray letter = gem.value("letter");
+        out += it.key() + "\t" + tblName(strings.tbl, it.key()) + "\t" + strings.runeLetters.value(letter, letter);
+        for (int i = 0; i < keys.size(); ++i)
+        {
+            QByteArray value = gem.value(keys.at(i));
+            if (keys.at(i).endsWith("code"))
+            {
+                if (value.isEmpty() || value == "hp/paragon" || value == "ac/runemaster")
+                {
+                    out += "\t\t\t";
+                    i += 2; // skip param and value
+                    continue;
+                }
+                value = statIdsFromPropertyStat(value);
+            }
+            out += "\t" + value;
+        }
+        out += "\n";
+    }
+    return out;
+}
+
+
+QByteArray DataCompiler::statIdsFromPropertyStat(const QByteArray &property, QByteArray *classSkillsParam /*= 0*/) const
+{
+    if (property.isEmpty())
+        return QByteArray();
+
+    // handle special cases
+    QByteArray propsStat;
+    if (property == "dmg-max" || property == "dmg-min")
+        propsStat = property.mid(4) + "damage";
+    else if (property == "dmg%")
+        propsStat = "item_maxdamage_percent";
+    if (!propsStat.isEmpty())
+        return _statIds.contains(propsStat) ? QByteArray::number(_statIds.value(propsStat)) : QByteArray();
+
+    const Record &propertyRecord = _properties.value(property);
+    QList<QByteArray> ids;
+    for (int i = 1; i <= 7; ++i)
+    {
+        QByteArray stat = propertyRecord.value("stat" + QByteArray::number(i));
+        if (stat.isEmpty() || !_statIds.contains(stat))
+            continue;
+        ids << QByteArray::number(_statIds.value(stat));
+        if (classSkillsParam && stat == "item_addclassskills")
+            *classSkillsParam = propertyRecord.value("param1");
+    }
+    return joined(ids, ',');
+}
+
+// converts property name to property id(s) in each first column, properties are copied from src if it's set
+void DataCompiler::expandSetProperties(const QList<QByteArray> &keys, Record *dst, const Record *src) const
+{
+    for (int i = 0; i < keys.size(); ++i)
+    {
+        const QByteArray &key = keys.at(i);
+        if (i % kFixedPropertyKeysSize == 0)
+        {
+            QByteArray param;
+            QByteArray ids = statIdsFromPropertyStat((src ? src : dst)->value(key), &param);
+            if (ids.isEmpty())
+                dst->remove(key);
+            else
+                dst->insert(key, ids);
+            if (!param.isEmpty()) // class skills
+                dst->insert(keys.at(i + 1), param);
+        }
+        else if (src && !dst->contains(key) && src->contains(key))
+            dst->insert(key, src->value(key));
+    }
+}
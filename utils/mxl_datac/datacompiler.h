@@ -0,0 +1,107 @@
+#ifndef DATACOMPILER_H
+#define DATACOMPILER_H
+
+#include <QHash>
+#include <QMap>
+#include <QStringList>
+
+
+// C++ port of txt_parser/txtparser.pl: turns the mod's .txt tables (saved as .tsv) and the .tbl strings into the
+// tab-separated tables ItemDataBase reads. The sources are parsed once by load(), after that every table is built
+// independently from them, so all tables of all locales can be generated in parallel.
+class DataCompiler
+{
+public:
+    enum Table
+    {
+        ItemTypes,
+        Sets,
+        BaseStats,
+        // localized tables start here
+        Items,
+        Uniques,
+        SetItems,
+        Skills,
+        Props,
+        Monsters,
+        Runewords,
+        Socketables,
+        TablesCount
+    };
+
+    static QString tableName(Table table); // file name without extension as ItemDataBase expects it
+    static bool isLocalized(Table table) { return table >= Items; }
+    static QStringList stringFiles(); // .tbl files converted to text, in the order their strings override each other
+
+    explicit DataCompiler(const QString &sourcePath) : _sourcePath(sourcePath) {} // the directory with txt/ and tbl/
+
+    QStringList availableLocales() const; // subdirectories of tbl/
+    bool load(const QStringList &locales, QString *error = 0); // parses all sources in parallel
+
+    QByteArray generate(Table table, const QString &locale = QString()) const; // thread-safe after load()
+    QByteArray statIdsHeader(const QString &headerName) const; // C++ enum of itemstatcost ids named after the 'Stat' column
+
+private:
+    typedef QHash<QByteArray, QByteArray> Record; // field -> non-empty value, missing fields are Perl's undef
+    typedef QList<Record> RecordList;             // by row number or index column, rows without values are empty
+    typedef QMap<QByteArray, Record> RecordMap;   // by key column, iterated in the order of Perl's sort()
+
+    struct SkipRule
+    {
+        int column;
+        QByteArray value;
+        bool isExactMatch; // otherwise it's enough for the column to contain the value
+    };
+
+    // one .tsv and the columns to take from it, rows with the same key are merged like parsetxt() does
+    struct TxtSource
+    {
+        enum KeyType { RowNumber, IndexColumn, KeyColumn };
+
+        QString fileName;
+        KeyType keyType;
+        int keyColumn;
+        QHash<QByteArray, int> columns;
+        QList<SkipRule> skipRules;
+        RecordList *list;
+        RecordMap *map;
+        QString error;
+    };
+
+    struct Strings
+    {
+        QString locale, path;
+        QHash<QByteArray, QByteArray> tbl;
+        QHash<QByteArray, QByteArray> runeLetters;
+        QString error;
+    };
+
+    QString _sourcePath;
+    RecordList _uniques, _setItems, _itemProperties, _skills, _monsters, _runewords, _baseStats;
+    RecordMap _properties, _sets, _armor, _weapons, _misc, _skillDescs, _gems, _itemTypes;
+    QHash<QByteArray, int> _statIds;                     // first itemstatcost id with this 'Stat'
+    QHash<QByteArray, const Record *> _itemTypesByCode;  // first item type with this 'Code'
+    QMap<QString, Strings> _strings;
+
+    static void parseTxt(TxtSource &source);
+    static void readStrings(Strings &strings);
+    TxtSource txtSource(const QString &fileName, TxtSource::KeyType keyType, int keyColumn, RecordList *list, RecordMap *map) const;
+    QList<TxtSource> txtSources(); // also clears the records they're parsed into
+
+    QByteArray generateItemTypes() const;
+    QByteArray generateSets() const;
+    QByteArray generateBaseStats() const;
+    QByteArray generateItems(const Strings &strings) const;
+    QByteArray generateUniques(const Strings &strings) const;
+    QByteArray generateSetItems(const Strings &strings) const;
+    QByteArray generateSkills(const Strings &strings) const;
+    QByteArray generateProps(const Strings &strings) const;
+    QByteArray generateMonsters(const Strings &strings) const;
+    QByteArray generateRunewords(const Strings &strings) const;
+    QByteArray generateSocketables(const Strings &strings) const;
+
+    QByteArray statIdsFromPropertyStat(const QByteArray &property, QByteArray *classSkillsParam = 0) const;
+    void expandSetProperties(const QList<QByteArray> &keys, Record *dst, const Record *src) const;
+};
+
+#endif // DATACOMPILER_H
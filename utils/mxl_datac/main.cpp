@@ -0,0 +1,222 @@
+#include "datacompiler.h"
+#include "chunkeddatafile.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QElapsedTimer>
+
+#if IS_QT5
+#include <QtConcurrent/QtConcurrentMap>
+#else
+#include <QtConcurrentMap>
+#endif
+
+#ifdef HAS_QTSQL
+#include <QtSql>
+#endif
+
+
+// one file in resources/data
+struct Job
+{
+    const DataCompiler *compiler;
+    DataCompiler::Table table; // TablesCount for files that are taken as is
+    QString locale, sourceFile, tsvFile, datFile; // sourceFile is set only for files taken as is, tsvFile only for generated ones
+    bool isCompressed;
+    QByteArray data;
+    QString error;
+};
+
+static bool writeFile(const QString &fileName, const QByteArray &data, QString *error)
+{
+    QDir().mkpath(QFileInfo(fileName).path());
+    QFile out(fileName);
+    if (!out.open(QIODevice::WriteOnly) || out.write(data) != data.size())
+    {
+        *error = QString("error writing file '%1'\nreason: %2").arg(fileName, out.errorString());
+        return false;
+    }
+    return true;
+}
+
+static void runJob(Job &job)
+{
+    if (job.table != DataCompiler::TablesCount)
+    {
+        job.data = job.compiler->generate(job.table, job.locale);
+        if (!writeFile(job.tsvFile, job.data, &job.error))
+            return;
+    }
+    else
+    {
+        QFile in(job.sourceFile);
+        if (!in.open(QIODevice::ReadOnly))
+        {
+            job.error = QString("error opening file '%1'\nreason: %2").arg(job.sourceFile, in.errorString());
+            return;
+        }
+        job.data = in.readAll();
+    }
+    writeFile(job.datFile, job.isCompressed ? ChunkedDataFile::compressed(job.data) : job.data, &job.error);
+}
+
+static Job copyJob(const QString &sourceFile, const QString &datFile, bool isCompressed)
+{
+    Job job;
+    job.compiler = 0;
+    job.table = DataCompiler::TablesCount;
+    job.sourceFile = sourceFile;
+    job.datFile = datFile;
+    job.isCompressed = isCompressed;
+    return job;
+}
+
+// items table for item creation dialogs (see ItemsDb)
+static bool writeItemsDatabase(const QString &fileName, const QByteArray &itemsTsv, QString *error)
+{
+#ifdef HAS_QTSQL
+    QFile::remove(fileName);
+    bool result = false;
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", "mxl_datac");
+        db.setDatabaseName(fileName);
+        if (db.open())
+        {
+            QSqlQuery query(db);
+            db.transaction();
+            if (query.exec("CREATE TABLE items (code TEXT PRIMARY KEY, name TEXT, tags TEXT, line TEXT)") && query.prepare("INSERT OR REPLACE INTO items(code, name, tags, line) VALUES (?, ?, ?, ?)"))
+            {
+                result = true;
+                foreach (const QByteArray &line, itemsTsv.split('\n'))
+                {
+                    QList<QByteArray> columns = line.split('\t');
+                    if (columns.size() < 2 || line.startsWith('#'))
+                        continue;
+                    query.addBindValue(QString::fromUtf8(columns.at(0).trimmed()));
+                    query.addBindValue(QString::fromUtf8(columns.at(1).trimmed()));
+                    query.addBindValue(QString::fromUtf8(line.mid(columns.at(0).size() + columns.at(1).size() + 2)));
+                    query.addBindValue(QString::fromUtf8(line));
+                    if (!query.exec())
+                    {
+                        result = false;
+                        break;
+                    }
+                }
+            }
+            if (result)
+                result = db.commit();
+            if (!result)
+                *error = query.lastError().text() + db.lastError().text();
+            // optional word prefix index for ItemsDb::findItems(), it falls back to LIKE if SQLite is built without FTS5
+            else if (!query.exec("CREATE VIRTUAL TABLE items_fts USING fts5(code UNINDEXED, name, tags, content='items', content_rowid='rowid')")
+                     || !query.exec("INSERT INTO items_fts(items_fts) VALUES('rebuild')"))
+            {
+                qWarning("items.db full-text index not created: %s", qPrintable(query.lastError().text()));
+                query.exec("DROP TABLE IF EXISTS items_fts");
+            }
+            db.close();
+        }
+        else
+            *error = db.lastError().text();
+    }
+    QSqlDatabase::removeDatabase("mxl_datac");
+    return result;
+#else
+    Q_UNUSED(fileName);
+    Q_UNUSED(itemsTsv);
+    *error = "built without Qt SQL";
+    return false;
+#endif
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 3)
+    {
+        qDebug("usage: mxl_datac <txt_parser path> <resources/data path> [stat ids header]\n"
+               "generates tables for every locale in <txt_parser path>/tbl, tables are also saved as .tsv in <txt_parser path>/generated");
+        return 1;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QString sourcePath = QString::fromLocal8Bit(argv[1]), dataPath = QString::fromLocal8Bit(argv[2]), generatedPath = sourcePath + "/generated";
+    DataCompiler compiler(sourcePath);
+    QStringList locales = compiler.availableLocales();
+    QString error;
+    if (locales.isEmpty() || !compiler.load(locales, &error))
+    {
+        qWarning("error loading sources from '%s'\nreason: %s", qPrintable(sourcePath), locales.isEmpty() ? "no locales in tbl/" : qPrintable(error));
+        return 1;
+    }
+
+    QList<Job> jobs;
+    for (int i = 0; i < DataCompiler::TablesCount; ++i)
+    {
+        DataCompiler::Table table = static_cast<DataCompiler::Table>(i);
+        QStringList tableLocales = DataCompiler::isLocalized(table) ? locales : QStringList(QString());
+        foreach (const QString &locale, tableLocales)
+        {
+            QString fileName = locale.isEmpty() ? DataCompiler::tableName(table) : QString("%1/%2").arg(locale, DataCompiler::tableName(table));
+            Job job;
+            job.compiler = &compiler;
+            job.table = table;
+            job.locale = locale;
+            job.tsvFile = QString("%1/%2.tsv").arg(generatedPath, fileName);
+            job.datFile = QString("%1/%2.dat").arg(dataPath, fileName);
+            job.isCompressed = true;
+            jobs << job;
+        }
+    }
+
+    // tables maintained by hand
+    jobs << copyJob(generatedPath + "/exptable.tsv", dataPath + "/exptable.dat", true);
+    foreach (const QString &locale, locales)
+    {
+        foreach (const QString &name, QStringList() << "LowQualityItems" << "mercs")
+        {
+            QString tsvFile = QString("%1/%2/%3.tsv").arg(generatedPath, locale, name);
+            if (QFile::exists(tsvFile))
+                jobs << copyJob(tsvFile, QString("%1/%2/%3.dat").arg(dataPath, locale, name), true);
+        }
+        foreach (const QString &name, DataCompiler::stringFiles())
+            jobs << copyJob(QString("%1/tbl/%2/%3.txt").arg(sourcePath, locale, name), QString("%1/%2/%3.dat").arg(dataPath, locale, name), false);
+    }
+
+    QtConcurrent::blockingMap(jobs, runJob);
+
+    int result = 0;
+    QByteArray itemsTsv;
+    foreach (const Job &job, jobs)
+    {
+        if (!job.error.isEmpty())
+        {
+            qWarning("%s", qPrintable(job.error));
+            result = 1;
+        }
+        else if (job.table == DataCompiler::Items && (itemsTsv.isEmpty() || job.locale == "en"))
+            itemsTsv = job.data;
+    }
+
+    if (!itemsTsv.isEmpty() && !writeItemsDatabase(dataPath + "/items.db", itemsTsv, &error))
+        qWarning("items.db not created: %s", qPrintable(error));
+
+    if (argc > 3)
+    {
+        QString headerFileName = QString::fromLocal8Bit(argv[3]);
+        QByteArray header = compiler.statIdsHeader(QFileInfo(headerFileName).fileName());
+        QFile current(headerFileName);
+        bool isChanged = !current.open(QIODevice::ReadOnly) || current.readAll() != header; // don't touch it to avoid rebuilding the app
+        current.close();
+        if (isChanged && !writeFile(headerFileName, header, &error))
+        {
+            qWarning("%s", qPrintable(error));
+            result = 1;
+        }
+    }
+
+    qDebug("%d files for %d locale(s) generated in %lld ms", jobs.size(), locales.size(), static_cast<long long>(timer.elapsed()));
+    return result;
+}
@@ -0,0 +1,25 @@
+TEMPLATE = app
+TARGET = mxl_datac
+DESTDIR = ../txt_parser
+
+QT += core
+QT -= gui
+greaterThan(QT_MAJOR_VERSION, 4) {
+    QT += concurrent
+    DEFINES += IS_QT5
+}
+qtHaveModule(sql) {
+    QT += sql
+    DEFINES += HAS_QTSQL
+}
+
+CONFIG += console
+CONFIG -= app_bundle
+
+INCLUDEPATH += ../../src
+
+SOURCES += main.cpp \
+           datacompiler.cpp \
+           ../../src/chunkeddatafile.cpp
+HEADERS += datacompiler.h \
+           ../../src/chunkeddatafile.h